@@ -1,7 +1,42 @@
 #pragma once
+#include <cstddef>
+#include <limits>
+
 constexpr auto CPPHTTPLIB_REDIRECT_MAX_COUNT = 20;
 constexpr auto CPPHTTPLIB_READ_TIMEOUT_SECOND = 5;
 constexpr auto CPPHTTPLIB_READ_TIMEOUT_USECOND = 0;
 constexpr auto CPPHTTPLIB_WRITE_TIMEOUT_SECOND = 5;
 constexpr auto CPPHTTPLIB_WRITE_TIMEOUT_USECOND = 0;
-constexpr auto CPPHTTPLIB_KEEPALIVE_MAX_COUNT = 5;
\ No newline at end of file
+constexpr auto CPPHTTPLIB_KEEPALIVE_MAX_COUNT = 5;
+constexpr auto CPPHTTPLIB_KEEPALIVE_TIMEOUT_SECOND = 5;
+constexpr auto CPPHTTPLIB_PIPELINE_MAX_DEPTH = 16;
+constexpr auto CPPHTTPLIB_RECV_BUFSIZ = size_t(4096u);
+constexpr auto CPPHTTPLIB_HEADER_MAX_LENGTH = size_t(8192u);
+constexpr auto CPPHTTPLIB_SESSION_POOL_MAX_SIZE = size_t(1024u);
+constexpr auto CPPHTTPLIB_ARENA_INITIAL_SIZE = size_t(8192u);
+constexpr auto CPPHTTPLIB_ARENA_MAX_SIZE = size_t(262144u);
+constexpr auto CPPHTTPLIB_FILE_CACHE_MAX_ENTRIES = size_t(1024u);
+constexpr auto CPPHTTPLIB_FILE_CACHE_TTL_MSECOND = 1000;
+constexpr auto CPPHTTPLIB_FILE_CHUNK_SIZE = size_t(65536u);
+constexpr auto CPPHTTPLIB_ASSET_CACHE_BYTE_BUDGET = size_t(67108864u);
+constexpr auto CPPHTTPLIB_ASSET_CACHE_MAX_FILE_SIZE = size_t(1048576u);
+constexpr auto CPPHTTPLIB_CONTENT_PROVIDER_CHUNK_SIZE = size_t(16384u);
+constexpr auto CPPHTTPLIB_COMPRESS_MIN_SIZE = size_t(1024u);
+constexpr auto CPPHTTPLIB_COMPRESS_CHUNK_SIZE = size_t(16384u);
+constexpr auto CPPHTTPLIB_COMPRESSOR_POOL_SIZE = size_t(8u);
+constexpr auto CPPHTTPLIB_BROTLI_QUALITY = 5;
+constexpr auto CPPHTTPLIB_ZSTD_LEVEL = 3;
+constexpr auto CPPHTTPLIB_CLIENT_MAX_IDLE_PER_HOST = size_t(8u);
+constexpr auto CPPHTTPLIB_CLIENT_MAX_CONNECTIONS_PER_HOST = size_t(64u);
+constexpr auto CPPHTTPLIB_CLIENT_IDLE_TIMEOUT_SECOND = 4;
+constexpr auto CPPHTTPLIB_CLIENT_RECV_BUFSIZ = size_t(16384u);
+constexpr auto CPPHTTPLIB_CLIENT_PAYLOAD_MAX_LENGTH = size_t(104857600u);
+constexpr auto CPPHTTPLIB_CLIENT_BODY_RESERVE_MAX = size_t(65536u);
+constexpr auto CPPHTTPLIB_THREAD_POOL_QUEUE_SIZE = size_t(4096u);
+constexpr auto CPPHTTPLIB_THREAD_POOL_SPIN_COUNT = 64;
+constexpr auto CPPHTTPLIB_TIMER_WHEEL_TICK_MSECOND = 100;
+constexpr auto CPPHTTPLIB_RETRY_AFTER_SECOND = 1;
+constexpr auto CPPHTTPLIB_REJECT_LINGER_MSECOND = 1000;
+constexpr auto CPPHTTPLIB_REJECT_MAX_LINGERING = size_t(256u);
+constexpr auto CPPHTTPLIB_HANDLER_MEMORY_SIZE = size_t(1024u);
+constexpr auto CPPHTTPLIB_PAYLOAD_MAX_LENGTH = (std::numeric_limits<size_t>::max)();
\ No newline at end of file
@@ -0,0 +1,294 @@
+#ifndef HTTP_ADMISSION_HPP
+#define HTTP_ADMISSION_HPP
+
+#include "const.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace http_asio {
+
+    // 򲢷ʱӵĴʽ
+    enum class OverloadAction {
+        Pause,      // ͣ acceptں˵ backlog Упټ
+        Reject      //  acceptֱдԤɵ 503 Retry-Afterر
+    };
+
+    // Ӧޣݴʱͬʱ
+    // update() ڶ reactor ߳ͬʱãlimit() ÿʱȡʵ豣֤̰߳ȫ㹻
+    class ConcurrencyLimit {
+    public:
+        virtual ~ConcurrencyLimit() = default;
+
+        virtual size_t limit() const = 0;
+
+        // latency ΪһӽѶ꣩Ӧĺʱinflight Ϊʱڴ
+        virtual void update(std::chrono::nanoseconds latency, size_t inflight) = 0;
+    };
+
+    // ԼAIMDʱ latency_threshold ʱ޳ backoff_ratio
+    // ޱһʱһδõʱӣʱ
+    class AimdLimit : public ConcurrencyLimit {
+    public:
+        AimdLimit(size_t initial_limit, std::chrono::nanoseconds latency_threshold,
+            size_t min_limit = 1, size_t max_limit = 1000, double backoff_ratio = 0.9)
+            : limit_(std::clamp(initial_limit, min_limit, max_limit)), latency_threshold_(latency_threshold),
+            min_limit_(min_limit), max_limit_(max_limit), backoff_ratio_(backoff_ratio) {}
+
+        size_t limit() const override {
+            return limit_.load(std::memory_order_relaxed);
+        }
+
+        void update(std::chrono::nanoseconds latency, size_t inflight) override {
+            size_t current = limit_.load(std::memory_order_relaxed);
+            size_t next;
+            do {
+                if (latency > latency_threshold_) {
+                    next = (std::max)(min_limit_, static_cast<size_t>(current * backoff_ratio_));
+                } else if (inflight * 2 >= current) {
+                    next = (std::min)(max_limit_, current + 1);
+                } else {
+                    return;
+                }
+            } while (next != current && !limit_.compare_exchange_weak(current, next, std::memory_order_relaxed));
+        }
+
+    private:
+        std::atomic<size_t> limit_;
+        std::chrono::nanoseconds latency_threshold_;
+        size_t min_limit_;
+        size_t max_limit_;
+        double backoff_ratio_;
+    };
+
+    // ݶ㷨Ƚϳƽʱһڵƽʱ
+    //   gradient = clamp(tolerance * long_rtt / short_rtt, 0.5, 1.0)
+    //   new_limit = limit * gradient + sqrt(limit)
+    // ʱʱްʱƽʱÿ sqrt(limit) Ŷƽ
+    // ڴۻÿ window_size һΣ reactor ͬʱϱʱȡֱӶ
+    class GradientLimit : public ConcurrencyLimit {
+    public:
+        explicit GradientLimit(size_t initial_limit = 20, size_t min_limit = 1, size_t max_limit = 1000,
+            size_t window_size = 32, double tolerance = 1.5, double smoothing = 0.2)
+            : limit_(std::clamp(initial_limit, min_limit, max_limit)), estimated_(static_cast<double>(limit_.load())),
+            min_limit_(min_limit), max_limit_(max_limit), window_size_((std::max)(window_size, size_t(1))),
+            tolerance_(tolerance), smoothing_(smoothing) {}
+
+        size_t limit() const override {
+            return limit_.load(std::memory_order_relaxed);
+        }
+
+        void update(std::chrono::nanoseconds latency, size_t inflight) override {
+            std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+            if (!lock.owns_lock()) {
+                return;
+            }
+            window_sum_ += static_cast<double>(latency.count());
+            window_max_inflight_ = (std::max)(window_max_inflight_, inflight);
+            if (++window_count_ < window_size_) {
+                return;
+            }
+
+            double short_rtt = (std::max)(window_sum_ / static_cast<double>(window_count_), 1.0);
+            size_t max_inflight = window_max_inflight_;
+            window_sum_ = 0;
+            window_count_ = 0;
+            window_max_inflight_ = 0;
+
+            // ƽȡԼ 600 ָƶƽֵԶڽֵʱ˵Ѿ½
+            long_rtt_ = long_rtt_ == 0 ? short_rtt : long_rtt_ + (short_rtt - long_rtt_) * window_size_ / 600.0;
+            if (long_rtt_ / short_rtt > 2) {
+                long_rtt_ *= 0.95;
+            }
+
+            // ûбõһʱ
+            if (static_cast<double>(max_inflight) < estimated_ / 2) {
+                return;
+            }
+
+            double gradient = std::clamp(tolerance_ * long_rtt_ / short_rtt, 0.5, 1.0);
+            double next = estimated_ * gradient + std::sqrt(estimated_);
+            next = estimated_ * (1 - smoothing_) + next * smoothing_;
+            estimated_ = std::clamp(next, static_cast<double>(min_limit_), static_cast<double>(max_limit_));
+            limit_.store(static_cast<size_t>(estimated_), std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<size_t> limit_;
+        std::mutex mutex_;
+        double estimated_;              // δȡ
+        double long_rtt_ = 0;
+        double window_sum_ = 0;
+        size_t window_count_ = 0;
+        size_t window_max_inflight_ = 0;
+        size_t min_limit_;
+        size_t max_limit_;
+        size_t window_size_;
+        double tolerance_;
+        double smoothing_;
+    };
+
+    // ׼ƵͳϢ
+    struct AdmissionStats {
+        size_t connections = 0;             // ǰ
+        size_t inflight = 0;                // ڴ
+        size_t limit = 0;                   // ǰĲޣ0 ʾ
+        size_t rejected_connections = 0;    // ޱܾ
+        size_t rejected_requests = 0;       // 򲢷޷ 503 
+    };
+
+    //  reactor õ׼ƣͬʱڵͬʱ޿ ConcurrencyLimit ̬
+    // ֻԭӲ·û
+    class AdmissionControl {
+    public:
+        AdmissionControl(size_t max_connections, size_t max_requests, std::chrono::seconds retry_after,
+            std::shared_ptr<ConcurrencyLimit> concurrency_limit)
+            : max_connections_(max_connections), max_requests_(max_requests), retry_after_(retry_after),
+            concurrency_limit_(std::move(concurrency_limit)) {
+            overload_response_ = "HTTP/1.1 503 Service Unavailable\r\nRetry-After: " + std::to_string(retry_after_.count()) +
+                "\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        }
+
+        AdmissionControl(const AdmissionControl&) = delete;
+        AdmissionControl& operator=(const AdmissionControl&) = delete;
+
+        // ӽʱãʱ falseӲ
+        bool try_acquire_connection() {
+            size_t count = connections_.fetch_add(1) + 1;
+            if (max_connections_ > 0 && count > max_connections_) {
+                connections_.fetch_sub(1);
+                rejected_connections_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            return true;
+        }
+
+        void release_connection() {
+            connections_.fetch_sub(1);
+            notify_capacity();
+        }
+
+        // ܾд 503 ҪȴԶ˹رգÿռһ
+        // ͬʱȴӴﵽ CPPHTTPLIB_REJECT_MAX_LINGERING ʱ false÷ӦֱӹرգӺˮľ
+        bool try_acquire_rejector() {
+            if (rejectors_.fetch_add(1) >= CPPHTTPLIB_REJECT_MAX_LINGERING) {
+                rejectors_.fetch_sub(1);
+                return false;
+            }
+            return true;
+        }
+
+        void release_rejector() {
+            rejectors_.fetch_sub(1);
+        }
+
+        // 봦ǰãʱ false÷Ӧ 503
+        bool try_begin_request() {
+            size_t count = inflight_.fetch_add(1) + 1;
+            size_t limit = request_limit();
+            if (limit > 0 && count > limit) {
+                inflight_.fetch_sub(1);
+                rejected_requests_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            return true;
+        }
+
+        // ӦѾlatency ΪʱڵӦ
+        void end_request(std::chrono::nanoseconds latency) {
+            size_t inflight = inflight_.fetch_sub(1);
+            if (concurrency_limit_) {
+                concurrency_limit_->update(latency, inflight);
+            }
+            notify_capacity();
+        }
+
+        // δɼӶϿûпɼĴʱʽ·ɣΪʱ
+        void cancel_request() {
+            inflight_.fetch_sub(1);
+            notify_capacity();
+        }
+
+        // 򲢷Ѵﵽ
+        bool overloaded() const {
+            if (max_connections_ > 0 && connections_.load() >= max_connections_) {
+                return true;
+            }
+            size_t limit = request_limit();
+            return limit > 0 && inflight_.load() >= limit;
+        }
+
+        // ͣ accept ǰãǼǵȴ set_capacity_handler õĻص
+        // ǼǺټһΣ false ʾѾָ÷Ӧм accept
+        bool wait_for_capacity() {
+            waiting_.store(true);
+            if (overloaded()) {
+                return true;
+            }
+            return !waiting_.exchange(false);
+        }
+
+        // ڷǰãص reactor ߳ϵ
+        void set_capacity_handler(std::function<void()> handler) {
+            capacity_handler_ = std::move(handler);
+        }
+
+        // ʱֱдӦ
+        const std::string& overload_response() const {
+            return overload_response_;
+        }
+
+        std::chrono::seconds retry_after() const {
+            return retry_after_;
+        }
+
+        AdmissionStats stats() const {
+            AdmissionStats stats;
+            stats.connections = connections_.load(std::memory_order_relaxed);
+            stats.inflight = inflight_.load(std::memory_order_relaxed);
+            stats.limit = request_limit();
+            stats.rejected_connections = rejected_connections_.load(std::memory_order_relaxed);
+            stats.rejected_requests = rejected_requests_.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+    private:
+        size_t max_connections_;                    // 0 ʾ
+        size_t max_requests_;                       // 0 ʾ
+        std::chrono::seconds retry_after_;
+        std::shared_ptr<ConcurrencyLimit> concurrency_limit_;
+        std::string overload_response_;
+        std::function<void()> capacity_handler_;
+        std::atomic<size_t> connections_{ 0 };
+        std::atomic<size_t> inflight_{ 0 };
+        std::atomic<size_t> rejectors_{ 0 };        // ڵȴԶ˹رյıܾ
+        std::atomic<bool> waiting_{ false };        //  acceptor ͣ
+        std::atomic<size_t> rejected_connections_{ 0 };
+        std::atomic<size_t> rejected_requests_{ 0 };
+
+        // ̶ӦȡС
+        size_t request_limit() const {
+            size_t limit = max_requests_;
+            if (concurrency_limit_) {
+                size_t adaptive = (std::max)(concurrency_limit_->limit(), size_t(1));
+                limit = limit > 0 ? (std::min)(limit, adaptive) : adaptive;
+            }
+            return limit;
+        }
+
+        void notify_capacity() {
+            if (waiting_.load() && !overloaded() && waiting_.exchange(false) && capacity_handler_) {
+                capacity_handler_();
+            }
+        }
+    };
+
+} // namespace http_asio
+
+#endif // HTTP_ADMISSION_HPP
@@ -0,0 +1,82 @@
+#ifndef HTTP_ARENA_HPP
+#define HTTP_ARENA_HPP
+
+#include "const.hpp"
+
+#include <memory_resource>
+#include <optional>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+namespace http_asio {
+
+    // Ӽĵstd::pmr::monotonic_buffer_resource
+    // ӦԤڴ˳䣬ͷǿղһ rewind() ա
+    // Ԥ鲻ʱȫֶ룬rewind() ʱĴСԤ飨 CPPHTTPLIB_ARENA_MAX_SIZE
+    // ӽȶ״̬ٵȫ malloc
+    class Arena {
+    public:
+        explicit Arena(size_t initial_size = CPPHTTPLIB_ARENA_INITIAL_SIZE)
+            : buffer_(initial_size) {
+            resource_.emplace(buffer_.data(), buffer_.size(), &upstream_);
+        }
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        // ַ Arena ڲ䣬rewind() Ȼ
+        std::pmr::memory_resource* resource() {
+            return &*resource_;
+        }
+
+        // ȫڴ棬ǰ뱣֤ûжʹô arena ڴ
+        void rewind() {
+            size_t overflow = upstream_.allocated();
+            if (overflow > 0 && buffer_.size() < CPPHTTPLIB_ARENA_MAX_SIZE) {
+                size_t size = (std::min)(buffer_.size() + overflow, CPPHTTPLIB_ARENA_MAX_SIZE);
+                resource_.reset();
+                buffer_.resize(size);
+                resource_.emplace(buffer_.data(), buffer_.size(), &upstream_);
+            } else {
+                resource_->release();
+            }
+            upstream_.reset();
+        }
+
+        size_t capacity() const {
+            return buffer_.size();
+        }
+
+    private:
+        // ¼Ԥȫֶֽ
+        class UpstreamResource : public std::pmr::memory_resource {
+        public:
+            size_t allocated() const { return allocated_; }
+            void reset() { allocated_ = 0; }
+
+        private:
+            size_t allocated_ = 0;
+
+            void* do_allocate(size_t bytes, size_t alignment) override {
+                allocated_ += bytes;
+                return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+            }
+
+            void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+                std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+            }
+
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+                return this == &other;
+            }
+        };
+
+        std::vector<std::byte> buffer_;
+        UpstreamResource upstream_;
+        std::optional<std::pmr::monotonic_buffer_resource> resource_;
+    };
+
+} // namespace http_asio
+
+#endif // HTTP_ARENA_HPP
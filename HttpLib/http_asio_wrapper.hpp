@@ -1,15 +1,52 @@
 #ifndef HTTP_ASIO_WRAPPER_HPP
 #define HTTP_ASIO_WRAPPER_HPP
 
+#include "const.hpp"
+
 #include <asio.hpp>
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <functional>
 #include <iostream>
 #include <thread>
 #include <fstream>
+#include <vector>
+#include <atomic>
+#include <stdexcept>
+#include <algorithm>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
 namespace http_asio {
 
+    // ǰ̰߳󶨵ָ CPU ϣƽ̨֧ʱ false
+    inline bool setCurrentThreadAffinity(size_t cpu) {
+#if defined(_WIN32)
+        return SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << cpu) != 0;
+#elif defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+        (void)cpu;
+        return false;
+#endif
+    }
+
+    // õǰ̵߳ƣڵ top -H ֣Linux ౣ 15 ַ
+    inline void setCurrentThreadName(const std::string& name) {
+#if defined(_WIN32)
+        SetThreadDescription(GetCurrentThread(), std::wstring(name.begin(), name.end()).c_str());
+#elif defined(__linux__)
+        pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#else
+        (void)name;
+#endif
+    }
+
     class IOContextWrapper {
     public:
         IOContextWrapper() : io_context_(std::make_shared<asio::io_context>()) {}
@@ -31,15 +68,38 @@ namespace http_asio {
 			std::cout << "IOContextWrapper destroyed" << std::endl;
 		}
 
+        // ¼ڸ io_context ϵĻѡʹ
+        void addConnection() {
+            active_connections_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void removeConnection() {
+            active_connections_.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        std::size_t activeConnections() const {
+            return active_connections_.load(std::memory_order_relaxed);
+        }
+
     private:
         std::shared_ptr<asio::io_context> io_context_;
+        std::atomic<std::size_t> active_connections_{ 0 };
+    };
+
+    // IOContextPool  io_context ķʽ
+    enum class ContextSelectMode {
+        RoundRobin,         // ѯ
+        LeastConnections    // ٵ
     };
 
 
+    // io_context أÿ io_context һ߳У work guardûʱ߳Ҳ˳
     class IOContextPool {
     public:
-        explicit IOContextPool(std::size_t pool_size)
-            : next_io_context_(0) {
+        // start_threads Ϊ false ʱҪɺ start()
+        explicit IOContextPool(std::size_t pool_size, ContextSelectMode mode = ContextSelectMode::RoundRobin,
+            bool start_threads = true)
+            : mode_(mode) {
             if (pool_size == 0) {
                 throw std::runtime_error("Pool size must be greater than 0");
             }
@@ -47,8 +107,11 @@ namespace http_asio {
             // IOContextWrapperʵ洢ڳ
             for (std::size_t i = 0; i < pool_size; ++i) {
                 auto context = std::make_shared<IOContextWrapper>();
+                work_guards_.push_back(asio::make_work_guard(*context->getContext()));
                 io_contexts_.push_back(context);
-                threads_.emplace_back([context]() { context->run(); });
+            }
+            if (start_threads) {
+                start();
             }
         }
 
@@ -57,25 +120,82 @@ namespace http_asio {
             join(); // ȴ߳
         }
 
-        // ȡһ io_context ʵѯ㷨
+        // ʱѵ i ̰߳󶨵 CPU i %  start() ֮ǰ
+        void setCpuAffinity(bool enable) {
+            cpu_affinity_ = enable;
+        }
+
+        // ߳ǰ׺ʵΪ "<prefix>-<i>" start() ֮ǰ
+        void setThreadName(std::string prefix) {
+            thread_name_ = std::move(prefix);
+        }
+
+        // Ϊÿ io_context һ̣߳ظЧ
+        void start() {
+            if (!threads_.empty()) {
+                return;
+            }
+            unsigned cores = (std::max)(1u, std::thread::hardware_concurrency());
+            for (std::size_t i = 0; i < io_contexts_.size(); ++i) {
+                threads_.emplace_back([this, i, cores]() {
+                    setCurrentThreadName(thread_name_ + "-" + std::to_string(i));
+                    if (cpu_affinity_) {
+                        setCurrentThreadAffinity(i % cores);
+                    }
+                    io_contexts_[i]->run();
+                });
+            }
+        }
+
+        // ȡһ io_context ʵ
         std::shared_ptr<asio::io_context> getNextContext() {
-            std::lock_guard<std::mutex> lock(mutex_);
-            auto io_context = io_contexts_[next_io_context_]->getContext();
-            next_io_context_ = (next_io_context_ + 1) % io_contexts_.size();
-            return io_context;
+            return io_contexts_[getNextIndex()]->getContext();
+        }
+
+        // ѡʽһ io_context ±꣬
+        std::size_t getNextIndex() {
+            if (mode_ == ContextSelectMode::LeastConnections) {
+                std::size_t best = 0;
+                std::size_t best_count = io_contexts_[0]->activeConnections();
+                for (std::size_t i = 1; i < io_contexts_.size() && best_count > 0; ++i) {
+                    std::size_t count = io_contexts_[i]->activeConnections();
+                    if (count < best_count) {
+                        best = i;
+                        best_count = count;
+                    }
+                }
+                return best;
+            }
+            return next_io_context_.fetch_add(1, std::memory_order_relaxed) % io_contexts_.size();
         }
 
-        // ֹͣе io_context ʵ
+        std::shared_ptr<IOContextWrapper> getWrapper(std::size_t index) {
+            return io_contexts_[index];
+        }
+
+        std::size_t size() const {
+            return io_contexts_.size();
+        }
+
+        // ͷ work guard io_context ߳Ȼ˳
+        void shutdown() {
+            for (auto& guard : work_guards_) {
+                guard.reset();
+            }
+        }
+
+        // ֹͣе io_context ʵ
         void stop() {
+            shutdown();
             for (auto& context : io_contexts_) {
                 context->stop();
             }
         }
 
-        // ȴ߳
+        // ȴ߳ɣڳ߳еʱ߳
         void join() {
             for (auto& thread : threads_) {
-                if (thread.joinable()) {
+                if (thread.joinable() && thread.get_id() != std::this_thread::get_id()) {
                     thread.join();
                 }
             }
@@ -83,9 +203,12 @@ namespace http_asio {
 
     private:
         std::vector<std::shared_ptr<IOContextWrapper>> io_contexts_;
+        std::vector<asio::executor_work_guard<asio::io_context::executor_type>> work_guards_;
         std::vector<std::thread> threads_;
-        std::size_t next_io_context_;
-        std::mutex mutex_;
+        std::atomic<std::size_t> next_io_context_{ 0 };
+        ContextSelectMode mode_;
+        bool cpu_affinity_ = false;
+        std::string thread_name_ = "http-io";
     };
 
 
@@ -140,6 +263,93 @@ namespace http_asio {
         std::string buffer_;
     };
 
+    // Ϊͬһʱֻһ첽һϵĶдԤڴ顣
+    // asio Ϊ첽״̬ͨ HandlerAllocator ̬²ȫ operator new
+    // ռû򲻹ʱ˻صȫַ
+    class HandlerMemory {
+    public:
+        HandlerMemory() = default;
+        HandlerMemory(const HandlerMemory&) = delete;
+        HandlerMemory& operator=(const HandlerMemory&) = delete;
+
+        void* allocate(std::size_t size) {
+            if (!in_use_ && size <= sizeof(storage_)) {
+                in_use_ = true;
+                return &storage_;
+            }
+            return ::operator new(size);
+        }
+
+        void deallocate(void* pointer) {
+            if (pointer == &storage_) {
+                in_use_ = false;
+            } else {
+                ::operator delete(pointer);
+            }
+        }
+
+    private:
+        alignas(std::max_align_t) unsigned char storage_[CPPHTTPLIB_HANDLER_MEMORY_SIZE];
+        bool in_use_ = false;
+    };
+
+    //  HandlerMemory ķΪ handler Ĺassociated allocator asio
+    template <typename T>
+    class HandlerAllocator {
+    public:
+        using value_type = T;
+
+        explicit HandlerAllocator(HandlerMemory& memory) : memory_(&memory) {}
+
+        template <typename U>
+        HandlerAllocator(const HandlerAllocator<U>& other) noexcept : memory_(other.memory_) {}
+
+        bool operator==(const HandlerAllocator& other) const noexcept {
+            return memory_ == other.memory_;
+        }
+
+        T* allocate(std::size_t n) const {
+            return static_cast<T*>(memory_->allocate(sizeof(T) * n));
+        }
+
+        void deallocate(T* pointer, std::size_t) const {
+            memory_->deallocate(pointer);
+        }
+
+    private:
+        template <typename> friend class HandlerAllocator;
+        HandlerMemory* memory_;
+    };
+
+    //  handler װ
+    template <typename Handler>
+    class MemoryBoundHandler {
+    public:
+        using allocator_type = HandlerAllocator<Handler>;
+
+        MemoryBoundHandler(HandlerMemory& memory, Handler handler)
+            : memory_(&memory), handler_(std::move(handler)) {}
+
+        allocator_type get_allocator() const noexcept {
+            return allocator_type(*memory_);
+        }
+
+        template <typename... Args>
+        void operator()(Args&&... args) {
+            handler_(std::forward<Args>(args)...);
+        }
+
+    private:
+        HandlerMemory* memory_;
+        Handler handler_;
+    };
+
+    //  handler Ӧ첽 memory ״̬
+    template <typename Handler>
+    MemoryBoundHandler<std::decay_t<Handler>> bind_memory(HandlerMemory& memory, Handler&& handler) {
+        return MemoryBoundHandler<std::decay_t<Handler>>(memory, std::forward<Handler>(handler));
+    }
+
     // ʱ
     class TimerWrapper {
     public:
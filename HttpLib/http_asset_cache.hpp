@@ -0,0 +1,477 @@
+#ifndef HTTP_ASSET_CACHE_HPP
+#define HTTP_ASSET_CACHE_HPP
+
+#include "http_file.hpp"
+#include "http_compress.hpp"
+#include "http_util.hpp"
+#include "const.hpp"
+
+#include <asio.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#define HTTP_ASIO_HAS_INOTIFY 1
+#endif
+
+namespace http_asio {
+
+    // еһ̬ԴļݼԤѹ汾ÿ汾Ԥɵͷ顣
+    // ޸ģɱͬʱ
+    struct Asset {
+        // һ Content-Encoding µıʾ
+        struct Variant {
+            std::string body;
+            std::string etag;       // 汾 ETag ͬǿУҪͬıʾ ETag
+            std::string head;       // "Content-Type ... Content-Length: n\r\n" DateConnection ͽβ
+        };
+
+        std::string path;
+        FileStat stat;
+        std::string last_modified;
+        std::array<std::unique_ptr<Variant>, static_cast<size_t>(EncodingType::Count)> variants;  // Identity Ǵ
+        size_t bytes = 0;           // а汾ռõֽ뻺Ԥ
+
+        //  Accept-Encoding  q ֵеİ汾ѡ
+        const Variant& select(std::string_view accept_encoding) const {
+            EncodingType type = EncodingType::Identity;
+            if (!accept_encoding.empty()) {
+                type = select_encoding(accept_encoding,
+                    [this](EncodingType type) { return variants[static_cast<size_t>(type)] != nullptr; });
+            }
+            return *variants[static_cast<size_t>(type)];
+        }
+    };
+
+    // AssetCache ͳϢ
+    struct AssetCacheStats {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t evictions = 0;       // 򳬳Ԥ㱻̭Դ
+        size_t invalidations = 0;   // ļ仯ʧЧԴ
+        size_t entries = 0;
+        size_t bytes = 0;
+    };
+
+    // Сȵ㾲̬ԴJS/CSS/JSON ȣĽڻ档
+    // ״У preloadʱļԤ gzip/br/zstd 汾ETag ͷ飬ֱ֮ӴڴӦϵͳá
+    // ״·ϰĬϼѹpreload ʱ߼ѹͬһļͬʱֻһ߳롣
+    // ռò byte_budgetʱ LRU ̭ max_file_size ļֻ¼ stat sendfile ·
+    // Linux ͨ inotify ӹĿ¼ļ仯ʧЧƽ̨ ttl  stat У顣
+    class AssetCache {
+    public:
+        explicit AssetCache(size_t byte_budget = CPPHTTPLIB_ASSET_CACHE_BYTE_BUDGET,
+            size_t max_file_size = CPPHTTPLIB_ASSET_CACHE_MAX_FILE_SIZE,
+            std::chrono::milliseconds ttl = std::chrono::milliseconds(CPPHTTPLIB_FILE_CACHE_TTL_MSECOND))
+            : byte_budget_(byte_budget), max_file_size_(max_file_size), ttl_(ttl) {}
+
+        ~AssetCache() {
+            unwatch();
+        }
+
+        AssetCache(const AssetCache&) = delete;
+        AssetCache& operator=(const AssetCache&) = delete;
+
+        // ػԴδʱļļڡͨļ
+        // ͬһļ߳ʱ nullptr÷ sendfile · reactor ϵȴ
+        std::shared_ptr<const Asset> get(const std::string& path) {
+            auto now = std::chrono::steady_clock::now();
+            std::shared_ptr<const Asset> cached;
+            FileStat cached_stat;
+            bool expired = false;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto it = entries_.find(path);
+                if (it != entries_.end()) {
+                    if (watching_ || now - it->second.checked < ttl_) {
+                        lru_.splice(lru_.begin(), lru_, it->second.lru);
+                        if (it->second.asset) ++hits_;
+                        return it->second.asset;
+                    }
+                    cached = it->second.asset;
+                    cached_stat = it->second.stat;
+                    expired = true;
+                }
+            }
+
+            // δ inotify ʱڵԴ statδ仯ʹ
+            if (expired) {
+                FileStat st;
+                if (stat_file(path, st) && st.regular && st.size == cached_stat.size && st.mtime == cached_stat.mtime) {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    auto it = entries_.find(path);
+                    if (it != entries_.end() && it->second.asset == cached) {
+                        it->second.checked = now;
+                        lru_.splice(lru_.begin(), lru_, it->second.lru);
+                    }
+                    if (cached) ++hits_;
+                    return cached;
+                }
+                invalidate(path);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!loading_.emplace(path, false).second) {
+                    return nullptr;
+                }
+                ++misses_;
+            }
+            return load(path, false, true);
+        }
+
+        // ʱԤĿ¼µȫļݹ飩Ųµļ̭Դ
+        void preload(const std::string& dir) {
+            std::error_code ec;
+            for (auto it = std::filesystem::recursive_directory_iterator(dir, ec);
+                !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+                if (!it->is_regular_file(ec)) {
+                    continue;
+                }
+                std::string path = it->path().generic_string();
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (!loading_.emplace(path, false).second) {
+                        continue;
+                    }
+                }
+                load(path, true, false);
+            }
+        }
+
+        // ʹ path Լ path Ŀ¼µԴʧЧ
+        void invalidate(const std::string& path) {
+            auto under = [&path](const std::string& key) {
+                return key.compare(0, path.size(), path) == 0 && (key.size() == path.size() || key[path.size()] == '/');
+            };
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto it = entries_.begin(); it != entries_.end();) {
+                if (under(it->first)) {
+                    lru_.erase(it->second.lru);
+                    total_bytes_ -= it->second.bytes;
+                    it = entries_.erase(it);
+                    ++invalidations_;
+                } else {
+                    ++it;
+                }
+            }
+            // ļĿǾݣɺ󲻷뻺
+            for (auto& [key, stale] : loading_) {
+                if (under(key)) stale = true;
+            }
+        }
+
+        void clear() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            invalidations_ += entries_.size();
+            entries_.clear();
+            lru_.clear();
+            total_bytes_ = 0;
+            for (auto& [key, stale] : loading_) {
+                stale = true;
+            }
+        }
+
+        //  io_context ϼĿ¼ dirĿ¼ı仯֧ inotify ƽ̨ false ttl У
+        bool watch(asio::io_context& io_context, const std::string& dir) {
+#if defined(HTTP_ASIO_HAS_INOTIFY)
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!watcher_) {
+                int fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+                if (fd < 0) return false;
+                watcher_ = std::make_unique<Watcher>(io_context, fd, this);
+                watcher_->read();
+            }
+            watcher_->add(dir);
+            watching_ = true;
+            return true;
+#else
+            (void)io_context;
+            (void)dir;
+            return false;
+#endif
+        }
+
+        // ֹͣӣ watch ʹõ io_context ֮ǰ
+        void unwatch() {
+#if defined(HTTP_ASIO_HAS_INOTIFY)
+            std::unique_ptr<Watcher> watcher;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                watcher = std::move(watcher_);
+                watching_ = false;
+            }
+            if (watcher) {
+                watcher->close();
+            }
+#endif
+        }
+
+        AssetCacheStats stats() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            AssetCacheStats stats;
+            stats.hits = hits_;
+            stats.misses = misses_;
+            stats.evictions = evictions_;
+            stats.invalidations = invalidations_;
+            stats.entries = entries_.size();
+            stats.bytes = total_bytes_;
+            return stats;
+        }
+
+    private:
+        struct Entry {
+            std::shared_ptr<const Asset> asset;             // Ϊձʾļ max_file_sizeֻ¼ stat
+            FileStat stat;
+            size_t bytes = 0;                               // Ԥֽ
+            std::list<std::string>::iterator lru;
+            std::chrono::steady_clock::time_point checked;  // ϴȷļδ仯ʱ
+        };
+
+#if defined(HTTP_ASIO_HAS_INOTIFY)
+        // inotify  io_context 첽ȡÿӵĿ¼һ watch descriptor
+        class Watcher {
+        public:
+            Watcher(asio::io_context& io_context, int fd, AssetCache* cache)
+                : descriptor_(io_context, fd), cache_(cache), closed_(std::make_shared<std::atomic<bool>>(false)) {}
+
+            void add(const std::string& dir) {
+                std::error_code ec;
+                add_one(dir);
+                for (auto it = std::filesystem::recursive_directory_iterator(dir, ec);
+                    !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+                    if (it->is_directory(ec)) {
+                        add_one(it->path().generic_string());
+                    }
+                }
+            }
+
+            void read() {
+                auto closed = closed_;
+                descriptor_.async_read_some(asio::buffer(buffer_),
+                    [this, closed](std::error_code ec, std::size_t length) {
+                        if (closed->load() || ec == asio::error::operation_aborted) {
+                            return;
+                        }
+                        if (!ec) {
+                            handle_events(length);
+                        }
+                        read();
+                    });
+            }
+
+            void close() {
+                closed_->store(true);
+                asio::error_code ignored;
+                descriptor_.close(ignored);
+            }
+
+        private:
+            asio::posix::stream_descriptor descriptor_;
+            AssetCache* cache_;
+            std::shared_ptr<std::atomic<bool>> closed_;
+            std::mutex dirs_mutex_;
+            std::unordered_map<int, std::string> dirs_;   // watch descriptor -> Ŀ¼
+            alignas(inotify_event) std::array<char, 4096> buffer_;
+
+            void add_one(const std::string& dir) {
+                int wd = ::inotify_add_watch(descriptor_.native_handle(), dir.c_str(),
+                    IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF);
+                if (wd >= 0) {
+                    std::string path = dir;
+                    while (path.size() > 1 && path.back() == '/') path.pop_back();
+                    std::lock_guard<std::mutex> lock(dirs_mutex_);
+                    dirs_[wd] = path;
+                }
+            }
+
+            void handle_events(size_t length) {
+                size_t offset = 0;
+                while (offset + sizeof(inotify_event) <= length) {
+                    const auto* event = reinterpret_cast<const inotify_event*>(buffer_.data() + offset);
+                    offset += sizeof(inotify_event) + event->len;
+                    if (event->mask & IN_Q_OVERFLOW) {
+                        cache_->clear();  // ʧ¼ȫʧЧ
+                        continue;
+                    }
+                    std::string path;
+                    {
+                        //  cache_ ʱ dirs_mutex_ watch() ļ˳෴
+                        std::lock_guard<std::mutex> lock(dirs_mutex_);
+                        auto it = dirs_.find(event->wd);
+                        if (it == dirs_.end()) {
+                            continue;
+                        }
+                        if (event->mask & IN_IGNORED) {
+                            dirs_.erase(it);
+                            continue;
+                        }
+                        path = it->second;
+                    }
+                    if (event->len > 0) {
+                        path.append("/").append(event->name);
+                    }
+                    cache_->invalidate(path);
+                    if ((event->mask & IN_ISDIR) && (event->mask & (IN_CREATE | IN_MOVED_TO))) {
+                        add(path);  // ½Ŀ¼ҲҪ
+                    }
+                }
+            }
+        };
+
+        std::unique_ptr<Watcher> watcher_;
+#endif
+
+        size_t byte_budget_;
+        size_t max_file_size_;
+        std::chrono::milliseconds ttl_;
+        mutable std::mutex mutex_;
+        std::unordered_map<std::string, Entry> entries_;
+        std::unordered_map<std::string, bool> loading_;    // · -> ڼǷ invalidate
+        std::list<std::string> lru_;    // ʹõǰ
+        size_t total_bytes_ = 0;
+        bool watching_ = false;
+        size_t hits_ = 0;
+        size_t misses_ = 0;
+        size_t evictions_ = 0;
+        size_t invalidations_ = 0;
+
+        // ļ뻺棬ǰ loading_ еǼ pathļѹִ
+        std::shared_ptr<const Asset> load(const std::string& path, bool best, bool evict) {
+            std::shared_ptr<OpenFile> file;
+            std::shared_ptr<const Asset> asset;
+            try {
+                file = OpenFile::open(path);
+                if (file && file->size() <= max_file_size_) {
+                    asset = build(path, *file, best);
+                }
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                loading_.erase(path);
+                throw;
+            }
+            if (!file || (!asset && file->size() <= max_file_size_)) {
+                // ļڻȡʧܣ¼
+                std::lock_guard<std::mutex> lock(mutex_);
+                loading_.erase(path);
+                return nullptr;
+            }
+            insert(path, asset, file->stat(), evict);
+            return asset;
+        }
+
+        // ļݲɸ汾best  compress()
+        std::shared_ptr<const Asset> build(const std::string& path, const OpenFile& file, bool best) const {
+            auto asset = std::make_shared<Asset>();
+            asset->path = path;
+            asset->stat = file.stat();
+            asset->last_modified = file.last_modified();
+
+            std::string content(static_cast<size_t>(file.size()), '\0');
+            size_t done = 0;
+            while (done < content.size()) {
+                long long n = file.read_at(content.data() + done, content.size() - done, done);
+                if (n <= 0) return nullptr;
+                done += static_cast<size_t>(n);
+            }
+
+            std::string_view content_type = file.content_type();
+            bool compressible = can_compress(content_type);
+            for (size_t i = 1; compressible && i < asset->variants.size(); ++i) {
+                auto type = static_cast<EncodingType>(i);
+                if (type == EncodingType::Deflate) {
+                    continue;  // ֧ gzipٵ deflate 汾
+                }
+                std::string compressed;
+                // ѹûбС򲻱
+                if (encoding_supported(type) && compress(type, content, compressed, best) && compressed.size() < content.size()) {
+                    asset->variants[i] = make_variant(std::move(compressed), file.etag(), type, content_type, asset->last_modified);
+                }
+            }
+            asset->variants[0] = make_variant(std::move(content), file.etag(), EncodingType::Identity, content_type, asset->last_modified);
+
+            bool negotiated = false;
+            for (size_t i = 1; i < asset->variants.size(); ++i) {
+                negotiated = negotiated || asset->variants[i];
+            }
+            for (auto& variant : asset->variants) {
+                if (!variant) continue;
+                if (negotiated) {
+                    //  Content-Length ֮ǰContent-Length ڿĩβ
+                    size_t pos = variant->head.rfind("Content-Length: ");
+                    variant->head.insert(pos, "Vary: Accept-Encoding\r\n");
+                }
+                asset->bytes += variant->body.size() + variant->head.size() + variant->etag.size();
+            }
+            return asset;
+        }
+
+        static std::unique_ptr<Asset::Variant> make_variant(std::string body, std::string_view etag, EncodingType type,
+            std::string_view content_type, std::string_view last_modified) {
+            auto variant = std::make_unique<Asset::Variant>();
+            variant->etag.assign(etag);
+            if (type != EncodingType::Identity) {
+                variant->etag.insert(variant->etag.size() - 1, std::string("-").append(encoding_name(type)));
+            }
+            std::string& head = variant->head;
+            head.append("Content-Type: ").append(content_type).append("\r\n");
+            head.append("ETag: ").append(variant->etag).append("\r\n");
+            head.append("Last-Modified: ").append(last_modified).append("\r\n");
+            head.append("Accept-Ranges: bytes\r\n");
+            if (type != EncodingType::Identity) {
+                head.append("Content-Encoding: ").append(encoding_name(type)).append("\r\n");
+            }
+            head.append("Content-Length: ").append(std::to_string(body.size())).append("\r\n");
+            variant->body = std::move(body);
+            return variant;
+        }
+
+        // 뻺沢 path Ǽǣasset Ϊʱ¼ļ
+        // ڼ path  invalidate ʱݿѾڣ
+        // Ԥʱ̭δʹõԴevict Ϊ false ʱֱ̭ӷ
+        bool insert(const std::string& path, std::shared_ptr<const Asset> asset, const FileStat& stat, bool evict) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto loading = loading_.find(path);
+            bool stale = loading != loading_.end() && loading->second;
+            if (loading != loading_.end()) {
+                loading_.erase(loading);
+            }
+            size_t bytes = asset ? asset->bytes : path.size();
+            if (stale || bytes > byte_budget_ || (!evict && total_bytes_ + bytes > byte_budget_)) {
+                return false;
+            }
+            auto it = entries_.find(path);
+            if (it != entries_.end()) {
+                lru_.erase(it->second.lru);
+                total_bytes_ -= it->second.bytes;
+                entries_.erase(it);
+            }
+            while (total_bytes_ + bytes > byte_budget_ && !lru_.empty()) {
+                auto victim = entries_.find(lru_.back());
+                total_bytes_ -= victim->second.bytes;
+                entries_.erase(victim);
+                lru_.pop_back();
+                ++evictions_;
+            }
+            lru_.push_front(path);
+            entries_[path] = Entry{ std::move(asset), stat, bytes, lru_.begin(), std::chrono::steady_clock::now() };
+            total_bytes_ += bytes;
+            return true;
+        }
+    };
+
+} // namespace http_asio
+
+#endif // HTTP_ASSET_CACHE_HPP
@@ -1,10 +1,13 @@
 #ifndef HTTP_CLIENT_HPP
 #define HTTP_CLIENT_HPP
 
+#include "const.hpp"
 #include "http_types.hpp"
 #include "http_util.hpp"
 #include "http_response.hpp"
 #include "http_asio_wrapper.hpp"
+#include "http_compress.hpp"
+#include "http_parser.hpp"
 
 #include <asio.hpp>
 #include <string>
@@ -12,16 +15,531 @@
 #include <memory>
 #include <iostream>
 #include <future>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <chrono>
+#include <cstring>
 
 
 
 namespace http_asio {
 
+    // ɻصʱ Response Ϊ
+    using ResponseHandler = std::function<void(const asio::error_code&, Response)>;
+
+    // ͻӣһãֻһЧ
+    struct ClientConnection {
+        explicit ClientConnection(const asio::any_io_executor& executor) : socket(executor) {}
+
+        asio::ip::tcp::socket socket;
+        std::string buffer;
+        std::chrono::steady_clock::time_point idle_since;
+    };
+
+    //  host:port е keep-alive ӣÿ
+    // Ա Client еӱͬһ io_context ϡ
+    class ConnectionPool {
+    public:
+        using ConnectionPtr = std::unique_ptr<ClientConnection>;
+        // õʱǿգΪձʾֵһӵɵ÷н
+        using AcquireHandler = std::function<void(ConnectionPtr)>;
+
+        explicit ConnectionPool(size_t max_idle_per_host = CPPHTTPLIB_CLIENT_MAX_IDLE_PER_HOST,
+            size_t max_per_host = CPPHTTPLIB_CLIENT_MAX_CONNECTIONS_PER_HOST,
+            std::chrono::milliseconds idle_timeout = std::chrono::seconds(CPPHTTPLIB_CLIENT_IDLE_TIMEOUT_SECOND))
+            : max_idle_per_host_(max_idle_per_host), max_per_host_((std::max)(size_t(1), max_per_host)),
+              idle_timeout_(idle_timeout) {}
+
+        // ÿౣĿ
+        void set_max_idle_per_host(size_t count) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            max_idle_per_host_ = count;
+        }
+
+        // ÿޣʹ + Уﵽ޵Ŷӵȴӹ黹
+        void set_max_per_host(size_t count) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            max_per_host_ = (std::max)(size_t(1), count);
+        }
+
+        // гʱӲٸãӦСڷ keep-alive ʱ
+        void set_idle_timeout(std::chrono::milliseconds timeout) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            idle_timeout_ = timeout;
+        }
+
+        // һhandler ڵǰ߳ãҲӹ黹ʱ
+        void acquire(const std::string& key, AcquireHandler handler) {
+            ConnectionPtr conn;
+            std::vector<ConnectionPtr> expired;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                Host& host = hosts_[key];
+                auto now = std::chrono::steady_clock::now();
+                while (!host.idle.empty()) {
+                    // ȳȸ黹ӣϾɵȻ
+                    ConnectionPtr candidate = std::move(host.idle.back());
+                    host.idle.pop_back();
+                    if (now - candidate->idle_since < idle_timeout_ && is_alive(*candidate)) {
+                        conn = std::move(candidate);
+                        break;
+                    }
+                    expired.push_back(std::move(candidate));
+                }
+                if (!conn && host.active + host.idle.size() >= max_per_host_) {
+                    host.waiters.push_back(std::move(handler));
+                    return;
+                }
+                ++host.active;
+            }
+            handler(std::move(conn));
+        }
+
+        // 黹 acquire õconn Ϊջ򲻿ɸʱرӣһȴ
+        void release(const std::string& key, ConnectionPtr conn, bool reusable) {
+            AcquireHandler waiter;
+            ConnectionPtr dropped;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                Host& host = hosts_[key];
+                if (conn && !reusable) {
+                    dropped = std::move(conn);
+                }
+                if (!host.waiters.empty()) {
+                    waiter = std::move(host.waiters.front());
+                    host.waiters.pop_front();
+                }
+                else {
+                    --host.active;
+                    if (conn && host.idle.size() < max_idle_per_host_) {
+                        conn->idle_since = std::chrono::steady_clock::now();
+                        host.idle.push_back(std::move(conn));
+                    }
+                    else {
+                        dropped = std::move(conn);
+                    }
+                }
+            }
+            if (waiter) {
+                waiter(std::move(conn));
+            }
+        }
+
+        // رп
+        void clear() {
+            std::unordered_map<std::string, std::deque<ConnectionPtr>> idle;
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& [key, host] : hosts_) {
+                idle[key].swap(host.idle);
+            }
+        }
+
+        size_t idle_count(const std::string& key) const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = hosts_.find(key);
+            return it == hosts_.end() ? 0 : it->second.idle.size();
+        }
+
+        size_t active_count(const std::string& key) const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = hosts_.find(key);
+            return it == hosts_.end() ? 0 : it->second.active;
+        }
+
+    private:
+        struct Host {
+            std::deque<ConnectionPtr> idle;
+            size_t active = 0;          // ѷֳȥڽ
+            std::deque<AcquireHandler> waiters;
+        };
+
+        mutable std::mutex mutex_;
+        std::unordered_map<std::string, Host> hosts_;
+        size_t max_idle_per_host_;
+        size_t max_per_host_;
+        std::chrono::milliseconds idle_timeout_;
+
+        // ϲӦκοɶݣɶ˵Զѹرջ˶
+        static bool is_alive(ClientConnection& conn) {
+            if (!conn.socket.is_open()) {
+                return false;
+            }
+            asio::error_code ec;
+            conn.socket.non_blocking(true, ec);
+            char c;
+            conn.socket.receive(asio::buffer(&c, 1), asio::socket_base::message_peek, ec);
+            return ec == asio::error::would_block;
+        }
+    };
+
+    namespace detail {
+
+        // һ̣ȡ -> () -> д -> Ӧ -> 黹ӡ
+        // лص strand ִУʱʱдصᲢ
+        // Ӧ ResponseParser ϢֱӴӶ ContentReceiver建档
+        class ClientOperation : public std::enable_shared_from_this<ClientOperation> {
+        public:
+            ClientOperation(asio::any_io_executor executor, std::shared_ptr<ConnectionPool> pool,
+                std::string host, std::string port, std::string request, bool head_request, bool idempotent,
+                bool decompress, size_t payload_max_length, std::chrono::milliseconds timeout,
+                ContentReceiver receiver, Progress progress, ResponseHandler handler)
+                : executor_(executor), strand_(asio::make_strand(executor)), resolver_(strand_), timer_(strand_),
+                  pool_(std::move(pool)), host_(std::move(host)), port_(std::move(port)), key_(host_ + ":" + port_),
+                  request_(std::move(request)), head_request_(head_request), idempotent_(idempotent), decompress_(decompress),
+                  payload_max_length_(payload_max_length), timeout_(timeout), receiver_(std::move(receiver)),
+                  progress_(std::move(progress)), handler_(std::move(handler)) {}
+
+            void start() {
+                auto self = shared_from_this();
+                asio::post(strand_, [self]() {
+                    self->timer_.expires_after(self->timeout_);
+                    self->timer_.async_wait([self](const asio::error_code& ec) {
+                        if (!ec) {
+                            self->on_timeout();
+                        }
+                    });
+                    self->pool_->acquire(self->key_, [self](ConnectionPool::ConnectionPtr conn) {
+                        asio::post(self->strand_, [self, conn = std::move(conn)]() mutable {
+                            self->on_acquired(std::move(conn));
+                        });
+                    });
+                });
+            }
+
+        private:
+            asio::any_io_executor executor_;
+            asio::strand<asio::any_io_executor> strand_;
+            asio::ip::tcp::resolver resolver_;
+            asio::steady_timer timer_;
+            std::shared_ptr<ConnectionPool> pool_;
+            std::string host_;
+            std::string port_;
+            std::string key_;
+            std::string request_;
+            bool head_request_;
+            bool idempotent_;               // ԰ȫظ
+            bool decompress_;
+            size_t payload_max_length_;     // 浽 Response::Body Ϣ壨ѹ󣩵󳤶
+            std::chrono::milliseconds timeout_;
+            ContentReceiver receiver_;
+            Progress progress_;
+            ResponseHandler handler_;
+
+            ConnectionPool::ConnectionPtr conn_;
+            bool acquired_ = false;     // ǷѴӳõ
+            bool reused_ = false;       // ǰǷȡԿж
+            bool timed_out_ = false;
+            bool cancelled_ = false;    // ContentReceiver  Progress Ҫֹ
+            bool too_large_ = false;    // Ϣ峬 payload_max_length_
+            bool done_ = false;
+
+            // conn_->buffer  [read_begin_, read_end_) Ϊյδ
+            size_t read_begin_ = 0;
+            size_t read_end_ = 0;
+            ResponseParser parser_;
+            Response response_;
+            std::unique_ptr<Decompressor> decompressor_;
+            uint64_t received_ = 0;     // յϢֽѹǰ
+            uint64_t total_ = 0;        // Content-Lengthδ֪ʱΪ 0
+
+            void on_acquired(ConnectionPool::ConnectionPtr conn) {
+                acquired_ = true;
+                if (done_) {
+                    // ŶڼѾʱֱӻȥ
+                    pool_->release(key_, std::move(conn), true);
+                    return;
+                }
+                if (conn) {
+                    conn_ = std::move(conn);
+                    reused_ = true;
+                    write_request();
+                }
+                else {
+                    connect();
+                }
+            }
+
+            void connect() {
+                reused_ = false;
+                conn_ = std::make_unique<ClientConnection>(executor_);
+                auto self = shared_from_this();
+                resolver_.async_resolve(host_, port_,
+                    [self](const asio::error_code& ec, asio::ip::tcp::resolver::results_type results) {
+                        if (ec) {
+                            return self->fail(ec);
+                        }
+                        asio::async_connect(self->conn_->socket, results, asio::bind_executor(self->strand_,
+                            [self](const asio::error_code& ec, const asio::ip::tcp::endpoint&) {
+                                if (ec) {
+                                    return self->fail(ec);
+                                }
+                                asio::error_code ignored;
+                                self->conn_->socket.set_option(asio::ip::tcp::no_delay(true), ignored);
+                                self->write_request();
+                            }));
+                    });
+            }
+
+            void write_request() {
+                read_begin_ = read_end_ = 0;
+                parser_.reset(head_request_);
+                auto self = shared_from_this();
+                asio::async_write(conn_->socket, asio::buffer(request_), asio::bind_executor(strand_,
+                    [self](const asio::error_code& ec, size_t) {
+                        if (ec) {
+                            return self->fail(ec);
+                        }
+                        self->read_some();
+                    }));
+            }
+
+            // ׷Ӷȡ read_end_ ֮󣬻ֻʱ
+            void read_some() {
+                if (conn_->buffer.size() < read_end_ + CPPHTTPLIB_CLIENT_RECV_BUFSIZ) {
+                    conn_->buffer.resize(read_end_ + CPPHTTPLIB_CLIENT_RECV_BUFSIZ);
+                }
+                auto self = shared_from_this();
+                conn_->socket.async_read_some(asio::buffer(&conn_->buffer[read_end_], CPPHTTPLIB_CLIENT_RECV_BUFSIZ),
+                    asio::bind_executor(strand_, [self](const asio::error_code& ec, size_t length) {
+                        self->read_end_ += length;
+                        if (ec == asio::error::eof && self->parser_.headers_complete()) {
+                            return self->on_eof();
+                        }
+                        if (ec) {
+                            return self->fail(ec);
+                        }
+                        if (self->parser_.headers_complete()) {
+                            self->parse_body();
+                        }
+                        else {
+                            self->parse_head();
+                        }
+                    }));
+            }
+
+            void parse_head() {
+                for (;;) {
+                    ParseStatus status = parser_.parse(conn_->buffer.data() + read_begin_, read_end_ - read_begin_);
+                    if (status == ParseStatus::Error) {
+                        return fail(asio::error_code(asio::error::invalid_argument));
+                    }
+                    if (status == ParseStatus::Incomplete) {
+                        if (read_end_ - read_begin_ > CPPHTTPLIB_HEADER_MAX_LENGTH) {
+                            return fail(asio::error_code(asio::error::message_size));
+                        }
+                        return read_some();
+                    }
+                    //  100 Continue мӦ
+                    if (parser_.status() >= 100 && parser_.status() < 200 && parser_.status() != 101) {
+                        read_begin_ += parser_.head_length();
+                        parser_.reset(head_request_);
+                        continue;
+                    }
+                    break;
+                }
+
+                response_.StatCde = static_cast<StatusCode>(parser_.status());
+                response_.StatusMsg.assign(parser_.reason());
+                for (size_t i = 0; i < parser_.header_count(); ++i) {
+                    response_.Headers.add(parser_.header_name(i), parser_.header_value(i));
+                }
+                read_begin_ += parser_.head_length();
+                total_ = parser_.has_content_length() ? parser_.content_length() : 0;
+
+                if (decompress_) {
+                    auto content_encoding = response_.Headers.get(HeaderId::ContentEncoding);
+                    auto type = content_encoding ? parse_encoding(*content_encoding) : std::nullopt;
+                    // ֵ֧ı뱣ԭ÷
+                    decompressor_ = type ? make_decompressor(*type) : nullptr;
+                }
+                if (!receiver_ && !decompressor_ && total_ > 0) {
+                    if (total_ > payload_max_length_) {
+                        return fail(asio::error_code(asio::error::message_size));
+                    }
+                    // Content-Length ɶԶ˸ܾݴһԷ䣬ݵ
+                    response_.Body.reserve(static_cast<size_t>((std::min<uint64_t>)(total_, CPPHTTPLIB_CLIENT_BODY_RESERVE_MAX)));
+                }
+                parse_body();
+            }
+
+            void parse_body() {
+                for (;;) {
+                    size_t consumed = 0;
+                    std::string_view chunk;
+                    ParseStatus status = parser_.parse_body(conn_->buffer.data() + read_begin_,
+                        read_end_ - read_begin_, consumed, chunk);
+                    read_begin_ += consumed;
+                    switch (status) {
+                    case ParseStatus::BodyChunk:
+                        if (!deliver(chunk.data(), chunk.size())) {
+                            return fail(cancelled_ ? asio::error_code(asio::error::operation_aborted)
+                                : too_large_ ? asio::error_code(asio::error::message_size)
+                                : asio::error_code(asio::error::invalid_argument));
+                        }
+                        break;
+                    case ParseStatus::Complete:
+                        if (!body_complete()) {
+                            return fail(asio::error_code(asio::error::invalid_argument));
+                        }
+                        return finish();
+                    case ParseStatus::Incomplete:
+                        compact();
+                        return read_some();
+                    default:
+                        return fail(asio::error_code(asio::error::invalid_argument));
+                    }
+                }
+            }
+
+            // ӱԶ˹رգԹرΪӦʹ˽Ӧض
+            void on_eof() {
+                if (parser_.finish() != ParseStatus::Complete) {
+                    return fail(asio::error_code(asio::error::eof));
+                }
+                if (!body_complete()) {
+                    return fail(asio::error_code(asio::error::invalid_argument));
+                }
+                finish();
+            }
+
+            // յѹʱϢѹضϵ decompress вᱨ
+            bool body_complete() const {
+                return !decompressor_ || received_ == 0 || decompressor_->is_complete();
+            }
+
+            // δݣ粻ķֿ鳤УƵͷ
+            void compact() {
+                if (read_begin_ == read_end_) {
+                    read_begin_ = read_end_ = 0;
+                }
+                else if (read_begin_ > 0) {
+                    std::memmove(conn_->buffer.data(), conn_->buffer.data() + read_begin_, read_end_ - read_begin_);
+                    read_end_ -= read_begin_;
+                    read_begin_ = 0;
+                }
+            }
+
+            // ϢξѹContentReceiver򻺴浽 BodyͽȻص
+            bool deliver(const char* data, size_t size) {
+                received_ += size;
+                auto emit = [this](const char* data, size_t size) {
+                    if (receiver_) {
+                        if (!receiver_(data, size)) {
+                            cancelled_ = true;
+                            return false;
+                        }
+                        return true;
+                    }
+                    if (size > payload_max_length_ - response_.Body.size()) {
+                        too_large_ = true;
+                        return false;
+                    }
+                    response_.Body.append(data, size);
+                    return true;
+                };
+                bool ok = decompressor_ ? decompressor_->decompress(data, size, emit) : emit(data, size);
+                if (ok && progress_ && !progress_(received_, total_)) {
+                    cancelled_ = true;
+                    ok = false;
+                }
+                return ok;
+            }
+
+            void on_timeout() {
+                if (done_) {
+                    return;
+                }
+                timed_out_ = true;
+                resolver_.cancel();
+                if (conn_) {
+                    asio::error_code ignored;
+                    conn_->socket.close(ignored);
+                }
+                if (!acquired_) {
+                    // Ŷӣֺ on_acquired й黹
+                    complete(asio::error_code(asio::error::timed_out));
+                }
+            }
+
+            void fail(asio::error_code ec) {
+                if (done_) {
+                    return;
+                }
+                if (timed_out_) {
+                    ec = asio::error::timed_out;
+                }
+                // õӿѱرգûյκӦʱһһΡ
+                // ѾֻݵȵPOST / PATCH ֱӱ
+                else if (idempotent_ && reused_ && read_end_ == 0 && !parser_.headers_complete()) {
+                    conn_.reset();
+                    return connect();
+                }
+                conn_.reset();
+                pool_->release(key_, nullptr, false);
+                complete(ec);
+            }
+
+            void finish() {
+                if (done_) {
+                    return;
+                }
+                // Ӧ֮ж˵Զ˲Э飬Ӳٸ
+                bool reusable = parser_.keep_alive() && read_begin_ == read_end_;
+                pool_->release(key_, std::move(conn_), reusable);
+                complete(asio::error_code());
+            }
+
+            void complete(const asio::error_code& ec) {
+                done_ = true;
+                timer_.cancel();
+                decompressor_.reset();
+                auto handler = std::move(handler_);
+                handler(ec, ec ? Response() : std::move(response_));
+            }
+        };
+
+    } // namespace detail
+
+    // 첽 HTTP ͻˡڸ io_context ϣΪÿ󴴽̣߳
+    // Ӱ host:port ӳأӦá
     class Client {
     public:
-        Client(std::string url, std::shared_ptr<IOContextWrapper> io_context = std::make_shared<IOContextWrapper>())
-            : io_context_(io_context), socket_(*io_context->getContext()) {
-			parse_url(url);
+        // ʹڲ io_contextɿͻԼһ߳
+        explicit Client(std::string url)
+            : io_context_(std::make_shared<IOContextWrapper>()), executor_(io_context_->getContext()->get_executor()),
+              pool_(std::make_shared<ConnectionPool>()) {
+            parse_url(url);
+            work_guard_.emplace(io_context_->getContext()->get_executor());
+            thread_ = std::thread([context = io_context_->getContext()]() {
+                setCurrentThreadName("http-client");
+                context->run();
+            });
+        }
+
+        // ڵ÷ io_context ϣҪ÷ run
+        Client(std::string url, std::shared_ptr<IOContextWrapper> io_context)
+            : io_context_(std::move(io_context)), executor_(io_context_->getContext()->get_executor()),
+              pool_(std::make_shared<ConnectionPool>()) {
+            parse_url(url);
+        }
+
+        Client(std::string url, asio::any_io_executor executor)
+            : executor_(std::move(executor)), pool_(std::make_shared<ConnectionPool>()) {
+            parse_url(url);
+        }
+
+        Client(const Client&) = delete;
+        Client& operator=(const Client&) = delete;
+
+        // ڲ̵߳ȴе˳
+        ~Client() {
+            if (thread_.joinable()) {
+                pool_->clear();
+                work_guard_.reset();
+                thread_.join();
+            }
         }
 
 		void SetUrl(const std::string& url) {
@@ -30,84 +548,118 @@ namespace http_asio {
 
         // ͷ
         void set_header(const std::string& key, const std::string& value) {
-            Headers[key] = value;
+            Headers.set(key, value);
+        }
+
+        // ǷԶ Accept-Encoding ѹӦ壬ĬϿ
+        void set_decompress(bool enable) {
+            decompress_ = enable;
         }
 
-        // óʱ
+        // óʱǴȡӵӦ
         void set_timeout(std::chrono::seconds timeout) {
             timeout_ = timeout;
         }
 
+        // 浽 Response::Body Ӧ壨ѹ󣩵󳤶ȣʱ asio::error::message_size ʧܡ
+        // ʹ ContentReceiver ʱϢ岻棬ܴ
+        void set_payload_max_length(size_t length) {
+            payload_max_length_ = length;
+        }
+
+        // 滻ӳأͻ˿Թͬһ
+        void set_connection_pool(std::shared_ptr<ConnectionPool> pool) {
+            pool_ = std::move(pool);
+        }
+
+        ConnectionPool& connection_pool() {
+            return *pool_;
+        }
+
+        // token ǻص void(asio::error_code, Response)asio::use_future  asio::use_awaitable
+        template <typename CompletionToken>
+        auto async_send(std::string method, std::string path, std::string body, CompletionToken&& token) {
+            return async_send(std::move(method), std::move(path), std::move(body), nullptr, nullptr,
+                std::forward<CompletionToken>(token));
+        }
+
+        // receiver ǿʱϢ壨ѽѹֶν receiverٻ浽 Response::Body
+        // progress յֽ Content-Lengthδ֪ʱΪ 0һص false ʱֹ
+        template <typename CompletionToken>
+        auto async_send(std::string method, std::string path, std::string body, ContentReceiver receiver,
+            Progress progress, CompletionToken&& token) {
+            return asio::async_initiate<CompletionToken, void(asio::error_code, Response)>(
+                [this](auto handler, std::string method, std::string path, std::string body,
+                    ContentReceiver receiver, Progress progress) {
+                    // Э̵ɴֻƶһԷ std::function
+                    auto shared = std::make_shared<std::decay_t<decltype(handler)>>(std::move(handler));
+                    start_request(method, path, body, std::move(receiver), std::move(progress),
+                        [shared](const asio::error_code& ec, Response response) {
+                            (*shared)(ec, std::move(response));
+                        });
+                }, token, std::move(method), std::move(path), std::move(body), std::move(receiver), std::move(progress));
+        }
+
         //  GET 
         std::future<Response> Get(std::string path) {
-			path_ = path;
-            return send_request("GET");
+            return async_send("GET", std::move(path), std::string(), asio::use_future);
+        }
+
+        std::future<Response> Get(std::string path, Progress progress) {
+            return async_send("GET", std::move(path), std::string(), nullptr, std::move(progress), asio::use_future);
+        }
+
+        // ļأϢ彻 receiverڴ
+        std::future<Response> Get(std::string path, ContentReceiver receiver, Progress progress = nullptr) {
+            return async_send("GET", std::move(path), std::string(), std::move(receiver), std::move(progress),
+                asio::use_future);
         }
 
         //  POST 
-        std::future<Response> Post(const std::string& body) {
-            set_header("Content-Length", std::to_string(body.size()));
-            return send_request("POST");
+        std::future<Response> Post(std::string path, std::string body) {
+            return async_send("POST", std::move(path), std::move(body), asio::use_future);
         }
 
         //  PUT 
-        std::future<Response> Put(const std::string& url, const std::string& body) {
-            set_header("Content-Length", std::to_string(body.size()));
-            return send_request("PUT", url);
+        std::future<Response> Put(std::string path, std::string body) {
+            return async_send("PUT", std::move(path), std::move(body), asio::use_future);
         }
 
         //  DELETE 
-        std::future<Response> Del() {
-            return send_request("DELETE");
+        std::future<Response> Del(std::string path) {
+            return async_send("DELETE", std::move(path), std::string(), asio::use_future);
         }
 
 		//  OPTIONS 
-		std::future<Response> Options() {
-			return send_request("OPTIONS");
+		std::future<Response> Options(std::string path) {
+			return async_send("OPTIONS", std::move(path), std::string(), asio::use_future);
 		}
 
 		//  PATCH 
-		std::future<Response> Patch(const std::string& body) {
-			set_header("Content-Length", std::to_string(body.size()));
-			return send_request("PATCH",  body);
+		std::future<Response> Patch(std::string path, std::string body) {
+			return async_send("PATCH", std::move(path), std::move(body), asio::use_future);
 		}
 
-        
-
     private:
         std::shared_ptr<IOContextWrapper> io_context_;
-        asio::ip::tcp::socket socket_;
+        asio::any_io_executor executor_;
+        std::optional<asio::executor_work_guard<asio::io_context::executor_type>> work_guard_;
+        std::thread thread_;
+        std::shared_ptr<ConnectionPool> pool_;
         Header Headers;
         std::chrono::seconds timeout_{ 5 }; // ĬϳʱΪ5
+        bool decompress_ = true;
+        size_t payload_max_length_ = CPPHTTPLIB_CLIENT_PAYLOAD_MAX_LENGTH;
 		std::string host_;
-		std::string path_;
 		std::string port_ = "80";
 
-        // ͨ÷
-        std::future<Response> send_request(const std::string& method, const std::string& body = "") {
-            return std::async(std::launch::async, [this, method, body]() {
-                try {
-                    // ӷ
-                    connect_to_server();
-
-                    // ַ
-                    std::string request = build_request(method, body);
-
-                    // 
-                    asio::write(socket_, asio::buffer(request));
-
-                    // Ӧ
-                    Response response = read_response();
-
-                    // ر
-                    socket_.close();
-                    return response;
-
-                } catch (const std::exception& e) {
-                    std::cerr << "Error: " << e.what() << std::endl;
-                    return Response{ StatusCode::InternalServerError, "Internal Server Error" };
-                }
-                });
+        void start_request(const std::string& method, const std::string& path, const std::string& body,
+            ContentReceiver receiver, Progress progress, ResponseHandler handler) {
+            auto op = std::make_shared<detail::ClientOperation>(executor_, pool_, host_, port_,
+                build_request(method, path, body), method == "HEAD", isIdempotent(stringToHttpMethod(method)), decompress_,
+                payload_max_length_, std::chrono::duration_cast<std::chrono::milliseconds>(timeout_), std::move(receiver),
+                std::move(progress), std::move(handler));
+            op->start();
         }
 
         // URL
@@ -131,63 +683,40 @@ namespace http_asio {
             }
         }
 
-        // ӵ
-        void connect_to_server() {
-            asio::ip::tcp::resolver resolver(*io_context_->getContext());
-			// hostΪipֱַӣ
-			if (host_.find_first_of("0123456789.") != std::string::npos) {
-				asio::ip::tcp::endpoint endpoint(asio::ip::make_address(host_), std::stoi(port_));
-				socket_.connect(endpoint);
-				return;
-			}
-            auto endpoints = resolver.resolve(host_, port_);
-            asio::connect(socket_, endpoints.begin());
-        }
-
-        // ַ
-        std::string build_request(const std::string& method, const std::string& body) {
-            std::ostringstream request;
-            request << method << " " << path_ << " HTTP/1.1\r\n";
-            request << "Host: " << socket_.remote_endpoint().address().to_string() << "\r\n";
+        // ַĬϱ
+        std::string build_request(const std::string& method, const std::string& path, const std::string& body) {
+            std::string request;
+            request.reserve(256 + body.size());
+            request.append(method).append(" ").append(path.empty() ? "/" : path).append(" HTTP/1.1\r\n");
+            if (!Headers.has(HeaderId::Host)) {
+                request.append("Host: ").append(host_);
+                if (port_ != "80") {
+                    request.append(":").append(port_);
+                }
+                request.append("\r\n");
+            }
 
             // ͷ
             for (const auto& [key, value] : Headers) {
-                request << key << ": " << value << "\r\n";
+                request.append(key).append(": ").append(value).append("\r\n");
             }
-
-            request << "Connection: close\r\n"; // ر
-            request << "\r\n"; // ͷ
-
-            // 壨У
-            if (!body.empty()) {
-                request << body;
+            if (decompress_ && !Headers.has(HeaderId::AcceptEncoding)) {
+                std::string accept_encoding = accept_encoding_value();
+                if (!accept_encoding.empty()) {
+                    request.append("Accept-Encoding: ").append(accept_encoding).append("\r\n");
+                }
             }
+            if (!body.empty() || method == "POST" || method == "PUT" || method == "PATCH") {
+                request.append("Content-Length: ").append(std::to_string(body.size())).append("\r\n");
+            }
+            request.append("\r\n"); // ͷ
 
-            return request.str();
-        }
-
-        // ȡӦ
-        Response read_response() {
-            std::string response;
-
-            asio::read_until(socket_, asio::dynamic_buffer(response), "\r\n");
-
-            // ״̬
-            std::istringstream response_stream(response);
-            std::string http_version;
-            int status_code;
-            response_stream >> http_version >> status_code;
-
-            // ȡͷ
-            Header header = parse_headers(response);
-
-            // ȡӦ
-            std::string body;
-			body = asio::buffer_cast<const char*>(asio::dynamic_buffer(response).data());
-            return Response{ static_cast<StatusCode>(status_code), header, body };
+            // 壨У
+            request.append(body);
+            return request;
         }
     };
 
 } // namespace http_asio
 
-#endif // HTTP_CLIENT_HPP
\ No newline at end of file
+#endif // HTTP_CLIENT_HPP
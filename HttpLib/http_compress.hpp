@@ -0,0 +1,662 @@
+#ifndef HTTP_COMPRESS_HPP
+#define HTTP_COMPRESS_HPP
+
+#include "http_header.hpp"
+
+#include "const.hpp"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+
+// ѹ㷨ãCPPHTTPLIB_ZLIB_SUPPORTgzipCPPHTTPLIB_BROTLI_SUPPORTbrCPPHTTPLIB_ZSTD_SUPPORTzstd
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+#include <zlib.h>
+#endif
+#ifdef CPPHTTPLIB_BROTLI_SUPPORT
+#include <brotli/encode.h>
+#include <brotli/decode.h>
+#endif
+#ifdef CPPHTTPLIB_ZSTD_SUPPORT
+#include <zstd.h>
+#endif
+
+namespace http_asio {
+
+    // Content-EncodingIdentity ʾѹ
+    enum class EncodingType {
+        Identity,
+        Gzip,
+        Deflate,
+        Brotli,
+        Zstd,
+        Count
+    };
+
+    inline std::string_view encoding_name(EncodingType type) {
+        switch (type) {
+        case EncodingType::Gzip: return "gzip";
+        case EncodingType::Deflate: return "deflate";
+        case EncodingType::Brotli: return "br";
+        case EncodingType::Zstd: return "zstd";
+        default: return "identity";
+        }
+    }
+
+    // ʱǷ˸ѹ㷨
+    inline bool encoding_supported(EncodingType type) {
+        switch (type) {
+        case EncodingType::Identity: return true;
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+        case EncodingType::Gzip: return true;
+        case EncodingType::Deflate: return true;
+#endif
+#ifdef CPPHTTPLIB_BROTLI_SUPPORT
+        case EncodingType::Brotli: return true;
+#endif
+#ifdef CPPHTTPLIB_ZSTD_SUPPORT
+        case EncodingType::Zstd: return true;
+#endif
+        default: return false;
+        }
+    }
+
+    //  Content-Encoding еĵʶı뷵ؿ
+    inline std::optional<EncodingType> parse_encoding(std::string_view name) {
+        while (!name.empty() && (name.front() == ' ' || name.front() == '\t')) name.remove_prefix(1);
+        while (!name.empty() && (name.back() == ' ' || name.back() == '\t')) name.remove_suffix(1);
+        if (name.empty() || iequals(name, "identity")) return EncodingType::Identity;
+        if (iequals(name, "gzip") || iequals(name, "x-gzip")) return EncodingType::Gzip;
+        if (iequals(name, "deflate")) return EncodingType::Deflate;
+        if (iequals(name, "br")) return EncodingType::Brotli;
+        if (iequals(name, "zstd")) return EncodingType::Zstd;
+        return std::nullopt;
+    }
+
+    // ıݲֵѹͼƬƵȱѾѹ
+    inline bool can_compress(std::string_view content_type) {
+        content_type = content_type.substr(0, content_type.find(';'));
+        return content_type.substr(0, 5) == "text/" || content_type == "image/svg+xml"
+            || content_type == "application/javascript" || content_type == "application/json"
+            || content_type == "application/xml" || content_type == "application/xhtml+xml"
+            || content_type == "application/wasm";
+    }
+
+    // Accept-Encoding  coding  q ֵǧ֮һƣq=1 Ϊ 1000q=0 ʾܾ
+    // ûгʱȡ "*"  q ֵ"*" Ҳûʱ -1
+    inline int encoding_quality(std::string_view accept_encoding, std::string_view coding) {
+        int wildcard = -1;
+        while (!accept_encoding.empty()) {
+            size_t comma = accept_encoding.find(',');
+            std::string_view item = accept_encoding.substr(0, comma);
+            accept_encoding = comma == std::string_view::npos ? std::string_view() : accept_encoding.substr(comma + 1);
+
+            size_t semicolon = item.find(';');
+            std::string_view token = item.substr(0, semicolon);
+            while (!token.empty() && (token.front() == ' ' || token.front() == '\t')) token.remove_prefix(1);
+            while (!token.empty() && (token.back() == ' ' || token.back() == '\t')) token.remove_suffix(1);
+            bool is_wildcard = token == "*";
+            if (!is_wildcard && !iequals(token, coding)) {
+                continue;
+            }
+
+            int quality = 1000;
+            if (semicolon != std::string_view::npos) {
+                std::string_view params = item.substr(semicolon + 1);
+                size_t q = params.find("q=");
+                if (q == std::string_view::npos) q = params.find("Q=");
+                if (q != std::string_view::npos) {
+                    // qvalue = ( "0" [ "." 0*3DIGIT ] ) / ( "1" [ "." 0*3("0") ] )
+                    std::string_view value = params.substr(q + 2);
+                    quality = (!value.empty() && value[0] == '1') ? 1000 : 0;
+                    if (value.size() > 2 && value[0] == '0' && value[1] == '.') {
+                        int scale = 100;
+                        for (size_t i = 2; i < value.size() && i < 5 && value[i] >= '0' && value[i] <= '9'; ++i) {
+                            quality += (value[i] - '0') * scale;
+                            scale /= 10;
+                        }
+                    }
+                }
+            }
+            if (!is_wildcard) {
+                return quality;
+            }
+            wildcard = quality;
+        }
+        return wildcard;
+    }
+
+    //  Accept-Encoding  q ֵѡӦ룬available жĳֱǷá
+    // q ֵͬʱƫ zstd > br > gzip > deflateܣ identity  q ֵʱ Identity
+    template <typename Available>
+    inline EncodingType select_encoding(std::string_view accept_encoding, Available available) {
+        static constexpr EncodingType preferred[] = {
+            EncodingType::Zstd, EncodingType::Brotli, EncodingType::Gzip, EncodingType::Deflate };
+        EncodingType best = EncodingType::Identity;
+        int best_quality = 0;
+        for (EncodingType type : preferred) {
+            if (!available(type)) {
+                continue;
+            }
+            int quality = encoding_quality(accept_encoding, encoding_name(type));
+            if (quality > best_quality) {
+                best = type;
+                best_quality = quality;
+            }
+        }
+        if (best != EncodingType::Identity && encoding_quality(accept_encoding, "identity") > best_quality) {
+            return EncodingType::Identity;
+        }
+        return best;
+    }
+
+    // ڱõıѡ
+    inline EncodingType select_encoding(std::string_view accept_encoding) {
+        return select_encoding(accept_encoding, encoding_supported);
+    }
+
+    // ͻʱ͵ Accept-Encodingгõȫ
+    inline std::string accept_encoding_value() {
+        std::string value;
+        for (EncodingType type : { EncodingType::Zstd, EncodingType::Brotli, EncodingType::Gzip, EncodingType::Deflate }) {
+            if (encoding_supported(type)) {
+                if (!value.empty()) value.append(", ");
+                value.append(encoding_name(type));
+            }
+        }
+        return value;
+    }
+
+    using CompressionSink = std::function<bool(const char* data, size_t size)>;
+
+    // ʽѹݷֶ룬ÿεѹͨ sink ڴռܳ޹
+    class Compressor {
+    public:
+        using Sink = CompressionSink;
+
+        virtual ~Compressor() = default;
+
+        // last Ϊ true ʱѹʣݣsink  false ʱֹ
+        virtual bool compress(const char* data, size_t size, bool last, const Sink& sink) = 0;
+    };
+
+    // ʽѹѹݷֶ룬ѹͨ sink 
+    class Decompressor {
+    public:
+        using Sink = CompressionSink;
+
+        virtual ~Decompressor() = default;
+
+        // 𻵻 sink  false ʱ false
+        virtual bool decompress(const char* data, size_t size, const Sink& sink) = 0;
+
+        // ǷѹϢ飬ضϵ decompress вᱨ
+        virtual bool is_complete() const = 0;
+    };
+
+    namespace detail {
+        // ÿ̻߳ѹ/ѹġҪ KB Ĵں͹ϣʱֻá
+        // ͬһ߳ͬʱеĶȡһState ṩ reset()ʧֱܵͷ
+        template <typename State>
+        class StatePool {
+        public:
+            template <typename... Args>
+            static std::unique_ptr<State> acquire(int key, Args&&... args) {
+                auto& pool = local();
+                for (auto it = pool.rbegin(); it != pool.rend(); ++it) {
+                    if ((*it)->key == key) {
+                        auto state = std::move(*it);
+                        pool.erase(std::next(it).base());
+                        return state;
+                    }
+                }
+                auto state = std::make_unique<State>(std::forward<Args>(args)...);
+                state->key = key;
+                return state;
+            }
+
+            static void release(std::unique_ptr<State> state) {
+                auto& pool = local();
+                if (state && state->reset() && pool.size() < CPPHTTPLIB_COMPRESSOR_POOL_SIZE) {
+                    pool.push_back(std::move(state));
+                }
+            }
+
+        private:
+            static std::vector<std::unique_ptr<State>>& local() {
+                thread_local std::vector<std::unique_ptr<State>> pool;
+                return pool;
+            }
+        };
+    } // namespace detail
+
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+    namespace detail {
+        struct DeflateState {
+            z_stream strm{};
+            int key = 0;
+            bool valid;
+
+            DeflateState(int level, int window_bits) {
+                valid = deflateInit2(&strm, level, Z_DEFLATED, window_bits, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+            }
+            ~DeflateState() {
+                if (valid) deflateEnd(&strm);
+            }
+            bool reset() { return valid && deflateReset(&strm) == Z_OK; }
+        };
+
+        struct InflateState {
+            z_stream strm{};
+            int key = 0;
+            bool valid;
+
+            // windowBits Ϊ 15 + 32Զʶ gzip  zlib ʽ
+            InflateState() { valid = inflateInit2(&strm, 32 + 15) == Z_OK; }
+            ~InflateState() {
+                if (valid) inflateEnd(&strm);
+            }
+            bool reset() { return valid && inflateReset(&strm) == Z_OK; }
+        };
+    } // namespace detail
+
+    // gzip / deflate ʽѹz_stream ȡԵǰ̵߳Ļ棬ʱ黹
+    class GzipCompressor : public Compressor {
+    public:
+        explicit GzipCompressor(EncodingType type = EncodingType::Gzip, int level = Z_DEFAULT_COMPRESSION) {
+            int window_bits = type == EncodingType::Gzip ? 31 : 15;
+            state_ = detail::StatePool<detail::DeflateState>::acquire((level + 1) * 64 + window_bits, level, window_bits);
+        }
+
+        ~GzipCompressor() override {
+            detail::StatePool<detail::DeflateState>::release(std::move(state_));
+        }
+
+        bool compress(const char* data, size_t size, bool last, const Sink& sink) override {
+            if (!state_->valid) {
+                return false;
+            }
+            z_stream& strm = state_->strm;
+            std::array<char, CPPHTTPLIB_COMPRESS_CHUNK_SIZE> buffer;
+            do {
+                // avail_in Ϊ uIntݷֶ
+                size_t chunk = (std::min)(size, static_cast<size_t>(1u << 30));
+                strm.next_in = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(data));
+                strm.avail_in = static_cast<uInt>(chunk);
+                data += chunk;
+                size -= chunk;
+                int flush = (last && size == 0) ? Z_FINISH : Z_NO_FLUSH;
+
+                int ret;
+                do {
+                    strm.next_out = reinterpret_cast<Bytef*>(buffer.data());
+                    strm.avail_out = static_cast<uInt>(buffer.size());
+                    ret = deflate(&strm, flush);
+                    if (ret == Z_STREAM_ERROR) {
+                        return false;
+                    }
+                    size_t produced = buffer.size() - strm.avail_out;
+                    if (produced > 0 && !sink(buffer.data(), produced)) {
+                        return false;
+                    }
+                } while (strm.avail_out == 0);
+            } while (size > 0);
+            return true;
+        }
+
+    private:
+        std::unique_ptr<detail::DeflateState> state_;
+    };
+
+    // gzip / deflate ʽѹֶ֧ gzip Աβ
+    class GzipDecompressor : public Decompressor {
+    public:
+        GzipDecompressor() : state_(detail::StatePool<detail::InflateState>::acquire(0)) {}
+
+        ~GzipDecompressor() override {
+            detail::StatePool<detail::InflateState>::release(std::move(state_));
+        }
+
+        bool decompress(const char* data, size_t size, const Sink& sink) override {
+            if (!state_->valid) {
+                return false;
+            }
+            z_stream& strm = state_->strm;
+            std::array<char, CPPHTTPLIB_COMPRESS_CHUNK_SIZE> buffer;
+            while (size > 0) {
+                size_t chunk = (std::min)(size, static_cast<size_t>(1u << 30));
+                strm.next_in = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(data));
+                strm.avail_in = static_cast<uInt>(chunk);
+                data += chunk;
+                size -= chunk;
+                do {
+                    strm.next_out = reinterpret_cast<Bytef*>(buffer.data());
+                    strm.avail_out = static_cast<uInt>(buffer.size());
+                    int ret = inflate(&strm, Z_NO_FLUSH);
+                    if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) {
+                        return false;
+                    }
+                    size_t produced = buffer.size() - strm.avail_out;
+                    if (produced > 0 && !sink(buffer.data(), produced)) {
+                        return false;
+                    }
+                    complete_ = ret == Z_STREAM_END;
+                    if (ret == Z_STREAM_END) {
+                        if (strm.avail_in == 0) break;
+                        if (inflateReset(&strm) != Z_OK) return false;  // һ gzip Ա
+                    } else if (ret == Z_BUF_ERROR) {
+                        break;  // ûнչ
+                    }
+                } while (strm.avail_in > 0 || strm.avail_out == 0);
+            }
+            return true;
+        }
+
+        bool is_complete() const override {
+            return complete_;
+        }
+
+    private:
+        std::unique_ptr<detail::InflateState> state_;
+        bool complete_ = false;     // һ gzip ԱѶβ
+    };
+#endif
+
+#ifdef CPPHTTPLIB_BROTLI_SUPPORT
+    // br ʽѹbrotli ıʵã˲
+    class BrotliCompressor : public Compressor {
+    public:
+        explicit BrotliCompressor(int quality = CPPHTTPLIB_BROTLI_QUALITY)
+            : state_(BrotliEncoderCreateInstance(nullptr, nullptr, nullptr)) {
+            if (state_) {
+                BrotliEncoderSetParameter(state_, BROTLI_PARAM_QUALITY, static_cast<uint32_t>(quality));
+            }
+        }
+
+        ~BrotliCompressor() override {
+            if (state_) BrotliEncoderDestroyInstance(state_);
+        }
+
+        bool compress(const char* data, size_t size, bool last, const Sink& sink) override {
+            if (!state_) {
+                return false;
+            }
+            std::array<uint8_t, CPPHTTPLIB_COMPRESS_CHUNK_SIZE> buffer;
+            auto operation = last ? BROTLI_OPERATION_FINISH : BROTLI_OPERATION_PROCESS;
+            const uint8_t* next_in = reinterpret_cast<const uint8_t*>(data);
+            size_t avail_in = size;
+            while (true) {
+                uint8_t* next_out = buffer.data();
+                size_t avail_out = buffer.size();
+                if (!BrotliEncoderCompressStream(state_, operation, &avail_in, &next_in, &avail_out, &next_out, nullptr)) {
+                    return false;
+                }
+                size_t produced = buffer.size() - avail_out;
+                if (produced > 0 && !sink(reinterpret_cast<const char*>(buffer.data()), produced)) {
+                    return false;
+                }
+                bool done = last ? BrotliEncoderIsFinished(state_) : avail_in == 0;
+                if (done && !BrotliEncoderHasMoreOutput(state_)) {
+                    return true;
+                }
+            }
+        }
+
+    private:
+        BrotliEncoderState* state_;
+    };
+
+    class BrotliDecompressor : public Decompressor {
+    public:
+        BrotliDecompressor() : state_(BrotliDecoderCreateInstance(nullptr, nullptr, nullptr)) {}
+
+        ~BrotliDecompressor() override {
+            if (state_) BrotliDecoderDestroyInstance(state_);
+        }
+
+        bool decompress(const char* data, size_t size, const Sink& sink) override {
+            if (!state_) {
+                return false;
+            }
+            std::array<uint8_t, CPPHTTPLIB_COMPRESS_CHUNK_SIZE> buffer;
+            const uint8_t* next_in = reinterpret_cast<const uint8_t*>(data);
+            size_t avail_in = size;
+            while (true) {
+                uint8_t* next_out = buffer.data();
+                size_t avail_out = buffer.size();
+                auto result = BrotliDecoderDecompressStream(state_, &avail_in, &next_in, &avail_out, &next_out, nullptr);
+                if (result == BROTLI_DECODER_RESULT_ERROR) {
+                    return false;
+                }
+                size_t produced = buffer.size() - avail_out;
+                if (produced > 0 && !sink(reinterpret_cast<const char*>(buffer.data()), produced)) {
+                    return false;
+                }
+                if (result != BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT) {
+                    return true;
+                }
+            }
+        }
+
+        bool is_complete() const override {
+            return state_ && BrotliDecoderIsFinished(state_);
+        }
+
+    private:
+        BrotliDecoderState* state_;
+    };
+#endif
+
+#ifdef CPPHTTPLIB_ZSTD_SUPPORT
+    namespace detail {
+        struct ZstdCompressState {
+            ZSTD_CCtx* ctx = ZSTD_createCCtx();
+            int key = 0;
+
+            ~ZstdCompressState() { ZSTD_freeCCtx(ctx); }
+            bool reset() { return ctx && !ZSTD_isError(ZSTD_CCtx_reset(ctx, ZSTD_reset_session_only)); }
+        };
+
+        struct ZstdDecompressState {
+            ZSTD_DCtx* ctx = ZSTD_createDCtx();
+            int key = 0;
+
+            ~ZstdDecompressState() { ZSTD_freeDCtx(ctx); }
+            bool reset() { return ctx && !ZSTD_isError(ZSTD_DCtx_reset(ctx, ZSTD_reset_session_only)); }
+        };
+    } // namespace detail
+
+    // zstd ʽѹȡԵǰ̵߳Ļ
+    class ZstdCompressor : public Compressor {
+    public:
+        explicit ZstdCompressor(int level = CPPHTTPLIB_ZSTD_LEVEL)
+            : state_(detail::StatePool<detail::ZstdCompressState>::acquire(level)) {
+            if (state_->ctx) {
+                ZSTD_CCtx_setParameter(state_->ctx, ZSTD_c_compressionLevel, level);
+            }
+        }
+
+        ~ZstdCompressor() override {
+            detail::StatePool<detail::ZstdCompressState>::release(std::move(state_));
+        }
+
+        bool compress(const char* data, size_t size, bool last, const Sink& sink) override {
+            if (!state_->ctx) {
+                return false;
+            }
+            std::array<char, CPPHTTPLIB_COMPRESS_CHUNK_SIZE> buffer;
+            ZSTD_inBuffer input{ data, size, 0 };
+            auto mode = last ? ZSTD_e_end : ZSTD_e_continue;
+            while (true) {
+                ZSTD_outBuffer output{ buffer.data(), buffer.size(), 0 };
+                size_t remaining = ZSTD_compressStream2(state_->ctx, &output, &input, mode);
+                if (ZSTD_isError(remaining)) {
+                    return false;
+                }
+                if (output.pos > 0 && !sink(buffer.data(), output.pos)) {
+                    return false;
+                }
+                bool done = last ? remaining == 0 : input.pos == input.size;
+                if (done) {
+                    return true;
+                }
+            }
+        }
+
+    private:
+        std::unique_ptr<detail::ZstdCompressState> state_;
+    };
+
+    class ZstdDecompressor : public Decompressor {
+    public:
+        ZstdDecompressor() : state_(detail::StatePool<detail::ZstdDecompressState>::acquire(0)) {}
+
+        ~ZstdDecompressor() override {
+            detail::StatePool<detail::ZstdDecompressState>::release(std::move(state_));
+        }
+
+        bool decompress(const char* data, size_t size, const Sink& sink) override {
+            if (!state_->ctx) {
+                return false;
+            }
+            std::array<char, CPPHTTPLIB_COMPRESS_CHUNK_SIZE> buffer;
+            ZSTD_inBuffer input{ data, size, 0 };
+            while (true) {
+                ZSTD_outBuffer output{ buffer.data(), buffer.size(), 0 };
+                size_t ret = ZSTD_decompressStream(state_->ctx, &output, &input);
+                if (ZSTD_isError(ret)) {
+                    return false;
+                }
+                complete_ = ret == 0;
+                if (output.pos > 0 && !sink(buffer.data(), output.pos)) {
+                    return false;
+                }
+                // ûд˵ûп
+                if (input.pos == input.size && output.pos < output.size) {
+                    return true;
+                }
+            }
+        }
+
+        bool is_complete() const override {
+            return complete_;
+        }
+
+    private:
+        std::unique_ptr<detail::ZstdDecompressState> state_;
+        bool complete_ = false;     //  0 ʾһ frame 벢ȫ
+    };
+#endif
+
+    // Ӧʽѹδʱ nullptrlevel ֻ gzip / deflate-1 ΪĬϼ
+    inline std::unique_ptr<Compressor> make_compressor(EncodingType type, int level = -1) {
+        switch (type) {
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+        case EncodingType::Gzip:
+        case EncodingType::Deflate:
+            return std::make_unique<GzipCompressor>(type, level);
+#endif
+#ifdef CPPHTTPLIB_BROTLI_SUPPORT
+        case EncodingType::Brotli:
+            return std::make_unique<BrotliCompressor>();
+#endif
+#ifdef CPPHTTPLIB_ZSTD_SUPPORT
+        case EncodingType::Zstd:
+            return std::make_unique<ZstdCompressor>();
+#endif
+        default:
+            (void)level;
+            return nullptr;
+        }
+    }
+
+    // Ӧʽѹδʱ nullptr
+    inline std::unique_ptr<Decompressor> make_decompressor(EncodingType type) {
+        switch (type) {
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+        case EncodingType::Gzip:
+        case EncodingType::Deflate:
+            return std::make_unique<GzipDecompressor>();
+#endif
+#ifdef CPPHTTPLIB_BROTLI_SUPPORT
+        case EncodingType::Brotli:
+            return std::make_unique<BrotliDecompressor>();
+#endif
+#ifdef CPPHTTPLIB_ZSTD_SUPPORT
+        case EncodingType::Zstd:
+            return std::make_unique<ZstdDecompressor>();
+#endif
+        default:
+            return nullptr;
+        }
+    }
+
+    // һѹݣԤѹ̬Դbest Ϊ true ʱʹø㷨ѹʱԤ룩
+    // Ϊ false ʱʹʽѹͬĬϼ·ϰ룬߼ѹ 1 MiB ļҪ룩
+    // 㷨δûѹʧʱ false
+    inline bool compress(EncodingType type, std::string_view input, std::string& output, bool best = true) {
+        output.clear();
+        switch (type) {
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+        case EncodingType::Gzip:
+        case EncodingType::Deflate: {
+            z_stream strm{};
+            // windowBits Ϊ 15 + 16 ʱ gzip ʽ15 ʱ zlib ʽHTTP  deflate
+            int window_bits = type == EncodingType::Gzip ? 31 : 15;
+            int level = best ? Z_BEST_COMPRESSION : Z_DEFAULT_COMPRESSION;
+            if (deflateInit2(&strm, level, Z_DEFLATED, window_bits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+                return false;
+            }
+            output.resize(deflateBound(&strm, static_cast<uLong>(input.size())));
+            strm.next_in = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(input.data()));
+            strm.avail_in = static_cast<uInt>(input.size());
+            strm.next_out = reinterpret_cast<Bytef*>(output.data());
+            strm.avail_out = static_cast<uInt>(output.size());
+            int ret = deflate(&strm, Z_FINISH);
+            output.resize(strm.total_out);
+            deflateEnd(&strm);
+            return ret == Z_STREAM_END;
+        }
+#endif
+#ifdef CPPHTTPLIB_BROTLI_SUPPORT
+        case EncodingType::Brotli: {
+            size_t size = BrotliEncoderMaxCompressedSize(input.size());
+            output.resize(size);
+            int quality = best ? BROTLI_MAX_QUALITY : CPPHTTPLIB_BROTLI_QUALITY;
+            if (!BrotliEncoderCompress(quality, BROTLI_DEFAULT_WINDOW, BROTLI_MODE_TEXT,
+                input.size(), reinterpret_cast<const uint8_t*>(input.data()), &size,
+                reinterpret_cast<uint8_t*>(output.data()))) {
+                return false;
+            }
+            output.resize(size);
+            return true;
+        }
+#endif
+#ifdef CPPHTTPLIB_ZSTD_SUPPORT
+        case EncodingType::Zstd: {
+            output.resize(ZSTD_compressBound(input.size()));
+            int level = best ? 19 : CPPHTTPLIB_ZSTD_LEVEL;
+            size_t size = ZSTD_compress(output.data(), output.size(), input.data(), input.size(), level);
+            if (ZSTD_isError(size)) {
+                return false;
+            }
+            output.resize(size);
+            return true;
+        }
+#endif
+        default:
+            (void)input;    // ûκѹʱδʹ
+            (void)best;
+            return false;
+        }
+    }
+
+} // namespace http_asio
+
+#endif // HTTP_COMPRESS_HPP
@@ -1,6 +1,8 @@
 #ifndef HTTP_CONTENT_HPP
 #define HTTP_CONTENT_HPP
 
+#include "http_util.hpp"
+
 #include <asio.hpp>
 #include <string>
 #include <functional>
@@ -14,137 +16,20 @@ namespace http_asio {
     using ContentProvider = std::function<void(size_t offset, size_t max_size, std::function<void(const std::string&)>)>;
     using ChunkedContentProvider = std::function<void(size_t chunk_size, std::function<void(const std::string&)>)>;
 
-    // ContentReader࣬ڴHTTPݶȡͶಿ
-    class ContentReader : public std::enable_shared_from_this<ContentReader> {
+    // ContentReader HandlerWithContentReader ȡ
+    //  reader(receiver) עպ֮ÿյһݾͻصһ receiver
+    // ֱָӻ建档receiver  false ʱֹȡ 400
+    // Ӧȫŷͣ receiver Կ޸Ĵõ Response
+    class ContentReader {
     public:
-        ContentReader(asio::io_context& io_context, asio::ip::tcp::socket& socket, const std::string& boundary)
-            : socket_(socket), boundary_(boundary),buffer_(4096),
-            state_(ReadState::Idle){}
-
-        void setContentProvider(ContentProvider provider) {
-            content_provider_ = provider;
-        }
-
-        void setChunkedContentProvider(ChunkedContentProvider provider) {
-            chunked_content_provider_ = provider;
-        }
-
-        // 첽ȡ
-        void async_readContent(size_t max_size, std::function<void(const std::string&)> handler) {
-            if (content_provider_) {
-                content_provider_(current_offset_, max_size, handler);
-            }
-            else {
-                handler(""); // ûṩߣؿַ
-            }
-        }
-
-        // 첽ಿ
-        void async_parseMultipartData(std::function<void()> handler) {
-            auto self = shared_from_this();
-            async_readPart([this, self, handler](bool success) {
-                if (success) {
-                    // ݹýһ
-                    async_parseMultipartData(handler);
-                }
-                else {
-                    handler(); // ɻִ
-                }
-                });
-        }
-
-        // 첽ֿ鴫
-        void async_handleChunkedTransfer(std::function<void()> handler) {
-            if (!chunked_content_provider_) {
-                handler();
-                return;
-            }
-
-            auto self = shared_from_this();
-            size_t chunk_size = 4096; // 趨ĬϿС
-
-            async_readChunk(chunk_size, [this, self, handler](const std::string& chunk) {
-                if (chunk.empty()) {
-                    handler(); // 
-                    return;
-                }
+        using Reader = std::function<bool(ContentReceiver receiver)>;
 
-                processChunk(chunk);
+        explicit ContentReader(Reader reader) : reader_(std::move(reader)) {}
 
-                // ȡһ
-                async_handleChunkedTransfer(handler);
-                });
-        }
+        bool operator()(ContentReceiver receiver) const { return reader_(std::move(receiver)); }
 
     private:
-        enum class ReadState {
-            Idle,               // 
-            Reading,            // 
-            ParsingMultipart,   //
-            ChunkedTransfer     //
-        };
-
-        asio::ip::tcp::socket& socket_;
-        std::string boundary_;
-        ContentProvider content_provider_;
-        ChunkedContentProvider chunked_content_provider_;
-        size_t current_offset_ = 0;
-        ReadState state_;
-
-        // 첽ȡʹֵ
-        void async_readPart(std::function<void(bool)> handler) {
-            auto self = shared_from_this();
-            asio::async_read_until(socket_, asio::dynamic_buffer(buffer_), boundary_,
-                [this, self, handler](const asio::error_code& ec, std::size_t bytes_transferred) {
-                    if (!ec) {
-                        std::string part_header = extractHeader();
-                        std::string part_content = extractBody(bytes_transferred);
-                        processPart(part_header, part_content);
-                        handler(true);
-                    }
-                    else {
-                        handler(false); // ȡ
-                    }
-                });
-        }
-
-        // 첽ȡһ
-        void async_readChunk(size_t chunk_size, std::function<void(const std::string&)> handler) {
-            auto self = shared_from_this();
-            asio::async_read(socket_, asio::buffer(buffer_, chunk_size),
-                [this, self, handler](const asio::error_code& ec, std::size_t bytes_transferred) {
-                    if (!ec) {
-                        std::string chunk(buffer_.data(), bytes_transferred);
-                        handler(chunk);
-                    }
-                    else {
-                        handler(""); // ȡʧܣؿַ
-                    }
-                });
-        }
-
-        // һݿ
-        void processChunk(const std::string& chunk) {
-            // Ϳ
-            std::cout << "Processing chunk of size: " << chunk.size() << std::endl;
-        }
-
-        // ÿಿ
-        void processPart(const std::string& header, const std::string& content) {
-            std::cout << "Processing part with header: " << header << std::endl;
-        }
-
-        // α룺ӻȡͷϢ
-        std::string extractHeader() {
-            return "Part header data";
-        }
-
-        // α룺ӻȡ
-        std::string extractBody(size_t bytes_transferred) {
-            return std::string(buffer_.data(), bytes_transferred);
-        }
-
-        std::vector<char> buffer_; 
+        Reader reader_;
     };
 
 } // namespace http_asio
@@ -0,0 +1,376 @@
+#ifndef HTTP_FILE_HPP
+#define HTTP_FILE_HPP
+
+#include "http_types.hpp"
+#include "http_util.hpp"
+#include "const.hpp"
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <chrono>
+#include <ctime>
+#include <cstdint>
+#include <optional>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Linux ͨ sendfile(2) ļ HTTP_ASIO_NO_SENDFILE ɸΪû̬
+#if defined(__linux__) && !defined(HTTP_ASIO_NO_SENDFILE)
+#include <sys/sendfile.h>
+#define HTTP_ASIO_HAS_SENDFILE 1
+#endif
+
+namespace http_asio {
+
+    // ļ stat Ϣ
+    struct FileStat {
+        uint64_t size = 0;
+        std::time_t mtime = 0;
+        uint64_t inode = 0;
+        bool regular = false;
+        bool directory = false;
+    };
+
+    inline bool stat_file(const std::string& path, FileStat& out) {
+#if defined(_WIN32)
+        struct _stat64 st;
+        if (_stat64(path.c_str(), &st) != 0) return false;
+        out.regular = (st.st_mode & _S_IFREG) != 0;
+        out.directory = (st.st_mode & _S_IFDIR) != 0;
+#else
+        struct stat st;
+        if (::stat(path.c_str(), &st) != 0) return false;
+        out.regular = S_ISREG(st.st_mode);
+        out.directory = S_ISDIR(st.st_mode);
+#endif
+        out.size = static_cast<uint64_t>(st.st_size);
+        out.mtime = static_cast<std::time_t>(st.st_mtime);
+        out.inode = static_cast<uint64_t>(st.st_ino);
+        return true;
+    }
+
+    // ֻʽ򿪵ļʱرա
+    // ƫȡpread /  OVERLAPPED ƫƵ ReadFileıļλãɱͬʱʹá
+    class OpenFile {
+    public:
+#if defined(_WIN32)
+        using native_handle_type = HANDLE;
+#else
+        using native_handle_type = int;
+#endif
+
+        // ͨļʧܻͨļʱ nullptr
+        static std::shared_ptr<OpenFile> open(const std::string& path) {
+            FileStat st;
+            if (!stat_file(path, st) || !st.regular) {
+                return nullptr;
+            }
+#if defined(_WIN32)
+            HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (handle == INVALID_HANDLE_VALUE) return nullptr;
+#else
+            int handle = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (handle < 0) return nullptr;
+#endif
+            auto file = std::shared_ptr<OpenFile>(new OpenFile(handle, st));
+            file->content_type_ = find_content_type(path);
+            return file;
+        }
+
+        ~OpenFile() {
+#if defined(_WIN32)
+            CloseHandle(handle_);
+#else
+            ::close(handle_);
+#endif
+        }
+
+        OpenFile(const OpenFile&) = delete;
+        OpenFile& operator=(const OpenFile&) = delete;
+
+        //  offset ȡ size ֽڣضֽ -1
+        long long read_at(char* buf, size_t size, uint64_t offset) const {
+#if defined(_WIN32)
+            OVERLAPPED overlapped{};
+            overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFFu);
+            overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+            DWORD read = 0;
+            DWORD chunk = static_cast<DWORD>((std::min<size_t>)(size, 1u << 30));
+            if (!ReadFile(handle_, buf, chunk, &read, &overlapped)) {
+                return GetLastError() == ERROR_HANDLE_EOF ? 0 : -1;
+            }
+            return static_cast<long long>(read);
+#else
+            ssize_t n;
+            do {
+                n = ::pread(handle_, buf, size, static_cast<off_t>(offset));
+            } while (n < 0 && errno == EINTR);
+            return static_cast<long long>(n);
+#endif
+        }
+
+        native_handle_type native_handle() const { return handle_; }
+        const FileStat& stat() const { return stat_; }
+        uint64_t size() const { return stat_.size; }
+        const std::string& etag() const { return etag_; }
+        const std::string& last_modified() const { return last_modified_; }
+        std::string_view content_type() const { return content_type_; }
+
+        // չƶ Content-Typeδ֪ͷ application/octet-stream
+        static std::string_view find_content_type(std::string_view path) {
+            size_t dot = path.rfind('.');
+            size_t slash = path.find_last_of("/\\");
+            if (dot == std::string_view::npos || (slash != std::string_view::npos && dot < slash)) {
+                return "application/octet-stream";
+            }
+            std::string_view ext = path.substr(dot + 1);
+            struct Mapping { std::string_view ext; std::string_view type; };
+            static constexpr Mapping mappings[] = {
+                { "html", "text/html" }, { "htm", "text/html" }, { "css", "text/css" },
+                { "txt", "text/plain" }, { "js", "application/javascript" }, { "mjs", "application/javascript" },
+                { "json", "application/json" }, { "xml", "application/xml" }, { "xhtml", "application/xhtml+xml" },
+                { "svg", "image/svg+xml" }, { "png", "image/png" }, { "jpg", "image/jpeg" }, { "jpeg", "image/jpeg" },
+                { "gif", "image/gif" }, { "ico", "image/x-icon" }, { "webp", "image/webp" },
+                { "pdf", "application/pdf" }, { "wasm", "application/wasm" }, { "woff", "font/woff" },
+                { "woff2", "font/woff2" }, { "mp4", "video/mp4" }, { "mp3", "audio/mpeg" },
+            };
+            for (const auto& mapping : mappings) {
+                if (iequals(mapping.ext, ext)) return mapping.type;
+            }
+            return "application/octet-stream";
+        }
+
+    private:
+        OpenFile(native_handle_type handle, const FileStat& st)
+            : handle_(handle), stat_(st) {
+            // ɴС޸ʱɵ ETagļݱ仯ʱ֮仯
+            char buf[48];
+            int n = std::snprintf(buf, sizeof(buf), "\"%llx-%llx\"",
+                static_cast<unsigned long long>(st.mtime), static_cast<unsigned long long>(st.size));
+            etag_.assign(buf, n > 0 ? static_cast<size_t>(n) : 0);
+            last_modified_ = format_http_date(st.mtime);
+        }
+
+        native_handle_type handle_;
+        FileStat stat_;
+        std::string etag_;
+        std::string last_modified_;
+        std::string_view content_type_;
+    };
+
+    // 򿪵ļ stat Ļ棬 reactor á
+    //  ttl ֱӷأں statļδ仯С޸ʱ䡢inode ͬʱʹѴ򿪵
+    // ʱ̭δУһڷ͵ļ shared_ptr У̭Կɰȫȡ
+    class FileCache {
+    public:
+        explicit FileCache(size_t max_entries = CPPHTTPLIB_FILE_CACHE_MAX_ENTRIES,
+            std::chrono::milliseconds ttl = std::chrono::milliseconds(CPPHTTPLIB_FILE_CACHE_TTL_MSECOND))
+            : max_entries_(max_entries), ttl_(ttl) {}
+
+        std::shared_ptr<const OpenFile> open(const std::string& path) {
+            auto now = std::chrono::steady_clock::now();
+            std::shared_ptr<OpenFile> cached;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto it = entries_.find(path);
+                if (it != entries_.end()) {
+                    if (now - it->second.checked < ttl_) {
+                        return it->second.file;
+                    }
+                    cached = it->second.file;
+                }
+            }
+
+            // ϵͳ
+            std::shared_ptr<OpenFile> file;
+            FileStat st;
+            if (cached && stat_file(path, st) && st.regular && st.size == cached->stat().size
+                && st.mtime == cached->stat().mtime && st.inode == cached->stat().inode) {
+                file = cached;
+            } else {
+                file = OpenFile::open(path);
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!file) {
+                entries_.erase(path);
+                return nullptr;
+            }
+            if (entries_.size() >= max_entries_ && entries_.find(path) == entries_.end()) {
+                evict_oldest();
+            }
+            entries_[path] = Entry{ file, now };
+            return file;
+        }
+
+        void clear() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            entries_.clear();
+        }
+
+    private:
+        struct Entry {
+            std::shared_ptr<OpenFile> file;
+            std::chrono::steady_clock::time_point checked;
+        };
+
+        void evict_oldest() {
+            auto oldest = entries_.begin();
+            for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+                if (it->second.checked < oldest->second.checked) oldest = it;
+            }
+            if (oldest != entries_.end()) entries_.erase(oldest);
+        }
+
+        size_t max_entries_;
+        std::chrono::milliseconds ttl_;
+        std::mutex mutex_;
+        std::unordered_map<std::string, Entry> entries_;
+    };
+
+    // ̬ļĹص㣺mount_point ǰ׺µ·ӳ䵽 base_dir еļ
+    struct MountPoint {
+        std::string mount_point;
+        std::string base_dir;
+    };
+
+    // 淶 '/' ͷ·ϲظ '/'ȥ "."  ".."ĩβ '/'
+    // ·ͨ ".." Ŀ¼зǷַʱ false淶ͬһļֻһдֱΪ
+    inline bool normalize_path(std::string_view path, std::string& out) {
+        out.clear();
+        size_t i = 0;
+        while (i < path.size()) {
+            while (i < path.size() && path[i] == '/') ++i;
+            size_t begin = i;
+            while (i < path.size() && path[i] != '/') ++i;
+            std::string_view component = path.substr(begin, i - begin);
+            if (component.find('\0') != std::string_view::npos || component.find('\\') != std::string_view::npos) {
+                return false;
+            }
+            if (component == "..") {
+                if (out.empty()) return false;
+                out.resize(out.rfind('/'));
+            } else if (!component.empty() && component != ".") {
+                out.push_back('/');
+                out.append(component);
+            }
+        }
+        if (out.empty() || (!path.empty() && path.back() == '/')) {
+            out.push_back('/');
+        }
+        return true;
+    }
+
+    // ص·ӳΪļ·ûƥĹص·Ϸʱؿ
+    inline std::optional<std::string> resolve_file_path(const std::vector<MountPoint>& mounts, std::string_view request_path) {
+        for (const auto& mount : mounts) {
+            if (request_path.substr(0, mount.mount_point.size()) != mount.mount_point) {
+                continue;
+            }
+            std::string sub_path = url_decode(std::string(request_path.substr(mount.mount_point.size())));
+            if (!sub_path.empty() && sub_path[0] != '/' && mount.mount_point.back() != '/') {
+                continue;  // "/static" ƥ "/staticfoo"
+            }
+            std::string normalized;
+            if (!normalize_path(sub_path, normalized)) {
+                return std::nullopt;
+            }
+            std::string path = mount.base_dir + normalized;
+            if (path.back() == '/') {
+                path += "index.html";
+            }
+            return path;
+        }
+        return std::nullopt;
+    }
+
+    // If-None-Match е ETag бǷ etagȽϣ
+    inline bool etag_matches(std::string_view list, std::string_view etag) {
+        if (etag.substr(0, 2) == "W/") etag.remove_prefix(2);
+        while (!list.empty()) {
+            size_t comma = list.find(',');
+            std::string_view item = list.substr(0, comma);
+            while (!item.empty() && (item.front() == ' ' || item.front() == '\t')) item.remove_prefix(1);
+            while (!item.empty() && (item.back() == ' ' || item.back() == '\t')) item.remove_suffix(1);
+            if (item.substr(0, 2) == "W/") item.remove_prefix(2);
+            if (item == "*" || item == etag) return true;
+            if (comma == std::string_view::npos) break;
+            list.remove_prefix(comma + 1);
+        }
+        return false;
+    }
+
+    // ֽڷΧ
+    struct ByteRange {
+        uint64_t offset = 0;
+        uint64_t length = 0;
+    };
+
+    enum class RangeResult {
+        None,           // û Range ޷ΧӦ
+        Satisfiable,    // ЧΧӦ 206
+        Unsatisfiable   // ΧļСӦ 416
+    };
+
+    //  "bytes=start-end" / "bytes=start-" / "bytes=-suffix" ʽĵΧ
+    inline RangeResult parse_byte_range(std::string_view value, uint64_t size, ByteRange& out) {
+        if (value.substr(0, 6) != "bytes=") return RangeResult::None;
+        value.remove_prefix(6);
+        if (value.find(',') != std::string_view::npos) return RangeResult::None;
+
+        size_t dash = value.find('-');
+        if (dash == std::string_view::npos) return RangeResult::None;
+        auto number = [](std::string_view text, uint64_t& result) {
+            if (text.empty() || text.size() > 19) return false;
+            result = 0;
+            for (char c : text) {
+                if (c < '0' || c > '9') return false;
+                result = result * 10 + static_cast<uint64_t>(c - '0');
+            }
+            return true;
+        };
+
+        uint64_t first = 0, last = 0;
+        std::string_view first_text = value.substr(0, dash);
+        std::string_view last_text = value.substr(dash + 1);
+        if (first_text.empty()) {
+            //  N ֽ
+            if (!number(last_text, last)) return RangeResult::None;
+            if (last == 0 || size == 0) return RangeResult::Unsatisfiable;
+            out.length = (std::min)(last, size);
+            out.offset = size - out.length;
+            return RangeResult::Satisfiable;
+        }
+        if (!number(first_text, first)) return RangeResult::None;
+        if (last_text.empty()) {
+            last = size == 0 ? 0 : size - 1;
+        } else if (!number(last_text, last) || last < first) {
+            return RangeResult::None;
+        }
+        if (first >= size) return RangeResult::Unsatisfiable;
+        last = (std::min)(last, size - 1);
+        out.offset = first;
+        out.length = last - first + 1;
+        return RangeResult::Satisfiable;
+    }
+
+} // namespace http_asio
+
+#endif // HTTP_FILE_HPP
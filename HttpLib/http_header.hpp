@@ -0,0 +1,452 @@
+#ifndef HTTP_HEADER_HPP
+#define HTTP_HEADER_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace http_asio {
+
+    // ͷֶεıţжǷΪĳֶʱֻȽϱţȽַ
+    enum class HeaderId : uint8_t {
+        Unknown = 0,
+        Accept,
+        AcceptEncoding,
+        AcceptRanges,
+        Age,
+        Allow,
+        Authorization,
+        CacheControl,
+        Connection,
+        ContentDisposition,
+        ContentEncoding,
+        ContentLength,
+        ContentRange,
+        ContentType,
+        Cookie,
+        Date,
+        ETag,
+        Expect,
+        Expires,
+        Host,
+        IfMatch,
+        IfModifiedSince,
+        IfNoneMatch,
+        IfRange,
+        IfUnmodifiedSince,
+        KeepAlive,
+        LastModified,
+        Location,
+        Origin,
+        Range,
+        Referer,
+        RetryAfter,
+        Server,
+        SetCookie,
+        TransferEncoding,
+        Upgrade,
+        UserAgent,
+        Vary,
+        WWWAuthenticate,
+        Count
+    };
+
+    // ԴСдȽַ ASCII
+    inline bool iequals(std::string_view a, std::string_view b) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i) {
+            char x = a[i], y = b[i];
+            if (x >= 'A' && x <= 'Z') x = static_cast<char>(x - 'A' + 'a');
+            if (y >= 'A' && y <= 'Z') y = static_cast<char>(y - 'A' + 'a');
+            if (x != y) return false;
+        }
+        return true;
+    }
+
+    namespace detail {
+
+        // ԴСд FNV-1a ϣ
+        constexpr uint32_t hashHeaderName(std::string_view name) {
+            uint32_t hash = 2166136261u;
+            for (char c : name) {
+                if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+                hash ^= static_cast<uint8_t>(c);
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
+        struct KnownHeader {
+            std::string_view name;
+            uint32_t hash;
+        };
+
+        constexpr KnownHeader known(std::string_view name) {
+            return KnownHeader{ name, hashHeaderName(name) };
+        }
+
+        // ˳ HeaderId һ£ Unknown
+        inline constexpr std::array<KnownHeader, static_cast<size_t>(HeaderId::Count) - 1> kKnownHeaders = { {
+            known("Accept"),
+            known("Accept-Encoding"),
+            known("Accept-Ranges"),
+            known("Age"),
+            known("Allow"),
+            known("Authorization"),
+            known("Cache-Control"),
+            known("Connection"),
+            known("Content-Disposition"),
+            known("Content-Encoding"),
+            known("Content-Length"),
+            known("Content-Range"),
+            known("Content-Type"),
+            known("Cookie"),
+            known("Date"),
+            known("ETag"),
+            known("Expect"),
+            known("Expires"),
+            known("Host"),
+            known("If-Match"),
+            known("If-Modified-Since"),
+            known("If-None-Match"),
+            known("If-Range"),
+            known("If-Unmodified-Since"),
+            known("Keep-Alive"),
+            known("Last-Modified"),
+            known("Location"),
+            known("Origin"),
+            known("Range"),
+            known("Referer"),
+            known("Retry-After"),
+            known("Server"),
+            known("Set-Cookie"),
+            known("Transfer-Encoding"),
+            known("Upgrade"),
+            known("User-Agent"),
+            known("Vary"),
+            known("WWW-Authenticate"),
+        } };
+
+        // ԹϣֵλΪ±ĿѰַԪΪ HeaderId ֵ0 ʾղ
+        constexpr size_t kHeaderIdTableSize = 256;
+
+        constexpr std::array<uint8_t, kHeaderIdTableSize> buildHeaderIdTable() {
+            std::array<uint8_t, kHeaderIdTableSize> table{};
+            for (size_t i = 0; i < kKnownHeaders.size(); ++i) {
+                size_t slot = kKnownHeaders[i].hash & (kHeaderIdTableSize - 1);
+                while (table[slot] != 0) {
+                    slot = (slot + 1) & (kHeaderIdTableSize - 1);
+                }
+                table[slot] = static_cast<uint8_t>(i + 1);
+            }
+            return table;
+        }
+
+        inline constexpr std::array<uint8_t, kHeaderIdTableSize> kHeaderIdTable = buildHeaderIdTable();
+
+    } // namespace detail
+
+    // ֶϣҳֶεıţǳֶʱ HeaderId::Unknown
+    inline HeaderId headerIdOf(std::string_view name, uint32_t hash) {
+        size_t slot = hash & (detail::kHeaderIdTableSize - 1);
+        while (uint8_t value = detail::kHeaderIdTable[slot]) {
+            const detail::KnownHeader& known = detail::kKnownHeaders[value - 1];
+            if (known.hash == hash && iequals(known.name, name)) {
+                return static_cast<HeaderId>(value);
+            }
+            slot = (slot + 1) & (detail::kHeaderIdTableSize - 1);
+        }
+        return HeaderId::Unknown;
+    }
+
+    inline HeaderId headerIdOf(std::string_view name) {
+        return headerIdOf(name, detail::hashHeaderName(name));
+    }
+
+    // ֶεı׼д
+    inline std::string_view headerName(HeaderId id) {
+        if (id == HeaderId::Unknown || id == HeaderId::Count) return {};
+        return detail::kKnownHeaders[static_cast<size_t>(id) - 1].name;
+    }
+
+    // HTTP ͷֶ
+    // ֶԴСдֶͬοԳֶΣ Set-Cookie˳򱣴档
+    // ֵֶδͬһַУֶαǰ kInlineCapacity ڶڲ
+    // ֲʹö飻clear() ѷʱٷڴ档
+    // ÿֶαԤȼĹϣֵ HeaderIdֶΰŲңhas(HeaderId) ֻһλ
+    // ʱõ (name, value) ʽ string_view ԣ޸ǰЧ
+    class Header {
+    public:
+        static constexpr size_t kInlineCapacity = 16;
+
+        Header() = default;
+
+        // ֶݴ resource 
+        explicit Header(std::pmr::memory_resource* resource)
+            : data_(resource), overflow_(resource) {}
+
+        Header(std::initializer_list<std::pair<std::string_view, std::string_view>> fields) {
+            for (const auto& [name, value] : fields) {
+                add(name, value);
+            }
+        }
+
+        class const_iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::pair<std::string_view, std::string_view>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = value_type;
+
+            const_iterator() = default;
+            const_iterator(const Header* header, size_t index) : header_(header), index_(index) {}
+
+            value_type operator*() const {
+                return { header_->name(index_), header_->value(index_) };
+            }
+
+            // ǰֶεı
+            HeaderId id() const {
+                return header_->id(index_);
+            }
+
+            const_iterator& operator++() {
+                ++index_;
+                return *this;
+            }
+
+            const_iterator operator++(int) {
+                const_iterator old = *this;
+                ++index_;
+                return old;
+            }
+
+            bool operator==(const const_iterator& other) const {
+                return index_ == other.index_;
+            }
+
+            bool operator!=(const const_iterator& other) const {
+                return index_ != other.index_;
+            }
+
+        private:
+            const Header* header_ = nullptr;
+            size_t index_ = 0;
+        };
+
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, size_); }
+
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+
+        std::string_view name(size_t i) const {
+            const Entry& e = entry(i);
+            return std::string_view(data_.data() + e.name_offset, e.name_length);
+        }
+
+        std::string_view value(size_t i) const {
+            const Entry& e = entry(i);
+            return std::string_view(data_.data() + e.value_offset, e.value_length);
+        }
+
+        HeaderId id(size_t i) const {
+            return entry(i).id;
+        }
+
+        // ׷һֶΣֶͬʱԭе
+        void add(std::string_view name, std::string_view value) {
+            uint32_t hash = detail::hashHeaderName(name);
+            HeaderId id = headerIdOf(name, hash);
+            Entry e;
+            e.hash = hash;
+            e.id = id;
+            e.name_offset = static_cast<uint32_t>(data_.size());
+            e.name_length = static_cast<uint32_t>(name.size());
+            data_.append(name);
+            e.value_offset = static_cast<uint32_t>(data_.size());
+            e.value_length = static_cast<uint32_t>(value.size());
+            data_.append(value);
+            push(e);
+            present_ |= bit(id);
+        }
+
+        void add(HeaderId id, std::string_view value) {
+            add(headerName(id), value);
+        }
+
+        // ֶεֵ滻ֶͬ
+        void set(std::string_view name, std::string_view value) {
+            size_t index = find(name);
+            if (index == npos) {
+                add(name, value);
+                return;
+            }
+
+            Entry& e = entry(index);
+            if (value.size() <= e.value_length) {
+                // ֵȾֵʱԭظ
+                data_.replace(e.value_offset, value.size(), value);
+            } else {
+                e.value_offset = static_cast<uint32_t>(data_.size());
+                data_.append(value);
+            }
+            e.value_length = static_cast<uint32_t>(value.size());
+            erase_from(index + 1, e.hash, e.id, name);
+        }
+
+        void set(HeaderId id, std::string_view value) {
+            set(headerName(id), value);
+        }
+
+        // ɾֶͬΣǷɾֶ
+        bool remove(std::string_view name) {
+            size_t index = find(name);
+            if (index == npos) {
+                return false;
+            }
+            const Entry& e = entry(index);
+            erase_from(index, e.hash, e.id, name);
+            return true;
+        }
+
+        bool has(std::string_view name) const {
+            return find(name) != npos;
+        }
+
+        bool has(HeaderId id) const {
+            return (present_ & bit(id)) != 0;
+        }
+
+        // һֶͬεֵ
+        std::optional<std::string_view> get(std::string_view name) const {
+            size_t index = find(name);
+            if (index == npos) return std::nullopt;
+            return value(index);
+        }
+
+        std::optional<std::string_view> get(HeaderId id) const {
+            if (!has(id)) return std::nullopt;
+            for (size_t i = 0; i < size_; ++i) {
+                if (entry(i).id == id) return value(i);
+            }
+            return std::nullopt;
+        }
+
+        // ֶͬεֵ˳
+        std::vector<std::string_view> getAll(std::string_view name) const {
+            std::vector<std::string_view> values;
+            uint32_t hash = detail::hashHeaderName(name);
+            for (size_t i = 0; i < size_; ++i) {
+                if (matches(entry(i), hash, name)) values.push_back(value(i));
+            }
+            return values;
+        }
+
+        size_t count(std::string_view name) const {
+            size_t n = 0;
+            uint32_t hash = detail::hashHeaderName(name);
+            for (size_t i = 0; i < size_; ++i) {
+                if (matches(entry(i), hash, name)) ++n;
+            }
+            return n;
+        }
+
+        // ֶΣѷ
+        void clear() {
+            data_.clear();
+            overflow_.clear();
+            size_ = 0;
+            present_ = 0;
+        }
+
+    private:
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        struct Entry {
+            uint32_t name_offset = 0;
+            uint32_t name_length = 0;
+            uint32_t value_offset = 0;
+            uint32_t value_length = 0;
+            uint32_t hash = 0;
+            HeaderId id = HeaderId::Unknown;
+        };
+
+        std::pmr::string data_;                         // ֵֶ
+        std::array<Entry, kInlineCapacity> inline_{};   // ǰ kInlineCapacity ֶ
+        std::pmr::vector<Entry> overflow_;              // ֶ
+        size_t size_ = 0;
+        uint64_t present_ = 0;                          // ѳֵĳֶΣ HeaderId λ
+
+        static_assert(static_cast<size_t>(HeaderId::Count) <= 64, "HeaderId does not fit in the presence mask");
+
+        static uint64_t bit(HeaderId id) {
+            return id == HeaderId::Unknown ? 0 : (uint64_t(1) << static_cast<unsigned>(id));
+        }
+
+        Entry& entry(size_t i) {
+            return i < kInlineCapacity ? inline_[i] : overflow_[i - kInlineCapacity];
+        }
+
+        const Entry& entry(size_t i) const {
+            return i < kInlineCapacity ? inline_[i] : overflow_[i - kInlineCapacity];
+        }
+
+        void push(const Entry& e) {
+            if (size_ < kInlineCapacity) {
+                inline_[size_] = e;
+            } else {
+                overflow_.push_back(e);
+            }
+            ++size_;
+        }
+
+        bool matches(const Entry& e, uint32_t hash, std::string_view name) const {
+            return e.hash == hash && iequals(std::string_view(data_.data() + e.name_offset, e.name_length), name);
+        }
+
+        size_t find(std::string_view name) const {
+            uint32_t hash = detail::hashHeaderName(name);
+            for (size_t i = 0; i < size_; ++i) {
+                if (matches(entry(i), hash, name)) return i;
+            }
+            return npos;
+        }
+
+        //  index ʼɾ name ֶͬΣֶα˳
+        void erase_from(size_t index, uint32_t hash, HeaderId id, std::string_view name) {
+            size_t out = index;
+            for (size_t i = index; i < size_; ++i) {
+                const Entry& e = entry(i);
+                if (matches(e, hash, name)) continue;
+                if (out != i) entry(out) = e;
+                ++out;
+            }
+            while (size_ > out) {
+                if (size_ > kInlineCapacity) overflow_.pop_back();
+                --size_;
+            }
+            // index ֮ǰֶͬΣset һȻ
+            bool still_present = false;
+            for (size_t i = 0; i < index && id != HeaderId::Unknown; ++i) {
+                if (entry(i).id == id) {
+                    still_present = true;
+                    break;
+                }
+            }
+            if (!still_present) present_ &= ~bit(id);
+        }
+    };
+
+} // namespace http_asio
+
+#endif // HTTP_HEADER_HPP
@@ -0,0 +1,485 @@
+#ifndef HTTP_PARSER_HPP
+#define HTTP_PARSER_HPP
+
+#include "http_util.hpp"
+#include "http_scan.hpp"
+
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+namespace http_asio {
+
+    // ÿεõĽ
+    enum class ParseStatus {
+        Incomplete,         // ݲ㣬յݺӶϵ
+        HeadersComplete,    // кͷ
+        BodyChunk,          // õһϢ
+        Complete,           // Ϣ
+        Error               // ĸʽ
+    };
+
+    // ʽ HTTP Ľ״̬ӦͷϢĽֻʼкϢ֡ͬ
+    // ֱӻԭʼֽϽʼкͷ string_view ʽָ򻺳κο
+    // ͷ׶Σÿε parse Ϣʼʼȫݣϴͣµλüɨ衣
+    // Ϣ׶Σparse_body ÿֻ÷δѵݣصݿָͬ򻺳
+    // ص string_view ڻƶ򸲸ǰЧ
+    template <typename Derived>
+    class MessageParser {
+    public:
+        // ʼкͷdata Ϣʼʼ
+        ParseStatus parse(const char* data, size_t size) {
+            base_ = data;
+            if (state_ == State::Error) return ParseStatus::Error;
+            if (state_ != State::StartLine && state_ != State::Headers) return ParseStatus::HeadersComplete;
+
+            while (state_ == State::StartLine || state_ == State::Headers) {
+                const char* nl = scan::find_line_end(data + pos_, data + size);
+                if (nl == data + size) {
+                    pos_ = size;  // ´δɨ
+                    return ParseStatus::Incomplete;
+                }
+
+                size_t line_end = static_cast<size_t>(nl - data);
+                size_t next = line_end + 1;
+                size_t content_end = (line_end > line_start_ && data[line_end - 1] == '\r') ? line_end - 1 : line_end;
+
+                if (state_ == State::StartLine) {
+                    // ʼǰĿ
+                    if (content_end != line_start_) {
+                        if (!derived().parse_start_line(line_start_, content_end)) return fail();
+                        state_ = State::Headers;
+                    }
+                }
+                else if (content_end == line_start_) {
+                    head_length_ = next;
+                    if (!finish_headers()) return fail();
+                    return ParseStatus::HeadersComplete;
+                }
+                else if (!parse_header_line(line_start_, content_end)) {
+                    return fail();
+                }
+                line_start_ = pos_ = next;
+            }
+            return ParseStatus::HeadersComplete;
+        }
+
+        // Ϣ壬data Ϊδѵݣconsumed رѵֽ
+        ParseStatus parse_body(const char* data, size_t size, size_t& consumed, std::string_view& chunk) {
+            consumed = 0;
+            for (;;) {
+                size_t avail = size - consumed;
+                const char* p = data + consumed;
+                switch (state_) {
+                case State::Body: {
+                    if (remaining_ == 0) {
+                        state_ = State::Done;
+                        return ParseStatus::Complete;
+                    }
+                    if (avail == 0) return ParseStatus::Incomplete;
+                    size_t n = static_cast<size_t>(std::min<uint64_t>(avail, remaining_));
+                    chunk = std::string_view(p, n);
+                    consumed += n;
+                    remaining_ -= n;
+                    return ParseStatus::BodyChunk;
+                }
+                case State::UntilClose: {
+                    if (avail == 0) return ParseStatus::Incomplete;
+                    chunk = std::string_view(p, avail);
+                    consumed += avail;
+                    return ParseStatus::BodyChunk;
+                }
+                case State::ChunkSize: {
+                    const char* nl = scan::find_line_end(p, p + avail);
+                    if (nl == p + avail) {
+                        return avail > kMaxChunkLine ? fail() : ParseStatus::Incomplete;
+                    }
+                    if (!parse_chunk_size(p, nl)) return fail();
+                    consumed += static_cast<size_t>(nl - p) + 1;
+                    state_ = remaining_ == 0 ? State::Trailer : State::ChunkData;
+                    break;
+                }
+                case State::ChunkData: {
+                    if (avail == 0) return ParseStatus::Incomplete;
+                    size_t n = static_cast<size_t>(std::min<uint64_t>(avail, remaining_));
+                    chunk = std::string_view(p, n);
+                    consumed += n;
+                    remaining_ -= n;
+                    if (remaining_ == 0) state_ = State::ChunkDataEnd;
+                    return ParseStatus::BodyChunk;
+                }
+                case State::ChunkDataEnd: {
+                    if (avail == 0) return ParseStatus::Incomplete;
+                    if (p[0] == '\n') {
+                        consumed += 1;
+                    }
+                    else if (p[0] == '\r') {
+                        if (avail < 2) return ParseStatus::Incomplete;
+                        if (p[1] != '\n') return fail();
+                        consumed += 2;
+                    }
+                    else {
+                        return fail();
+                    }
+                    state_ = State::ChunkSize;
+                    break;
+                }
+                case State::Trailer: {
+                    // βֱֶӶбʾϢ
+                    const char* nl = scan::find_line_end(p, p + avail);
+                    if (nl == p + avail) {
+                        return avail > kMaxChunkLine ? fail() : ParseStatus::Incomplete;
+                    }
+                    size_t line_len = static_cast<size_t>(nl - p);
+                    consumed += line_len + 1;
+                    if (line_len == 0 || (line_len == 1 && p[0] == '\r')) {
+                        state_ = State::Done;
+                        return ParseStatus::Complete;
+                    }
+                    break;
+                }
+                case State::Done:
+                    return ParseStatus::Complete;
+                default:
+                    return fail();
+                }
+            }
+        }
+
+        // ѹرգԹرΪϢʹ˽˵Ϣض
+        ParseStatus finish() {
+            if (state_ == State::UntilClose || state_ == State::Done) {
+                state_ = State::Done;
+                return ParseStatus::Complete;
+            }
+            return fail();
+        }
+
+        bool headers_complete() const {
+            return state_ != State::StartLine && state_ != State::Headers && state_ != State::Error;
+        }
+
+        bool is_complete() const { return state_ == State::Done; }
+
+        size_t header_count() const { return headers_.size(); }
+        std::string_view header_name(size_t i) const { return view(headers_[i].name); }
+        std::string_view header_value(size_t i) const { return view(headers_[i].value); }
+
+        // ʼͷβУܳ
+        size_t head_length() const { return head_length_; }
+        uint64_t content_length() const { return content_length_; }
+        bool has_content_length() const { return has_content_length_; }
+        bool is_chunked() const { return chunked_; }
+        // ϢӹرΪ
+        bool is_close_delimited() const { return close_delimited_; }
+
+    protected:
+        enum class State {
+            StartLine,
+            Headers,
+            Body,
+            UntilClose,
+            ChunkSize,
+            ChunkData,
+            ChunkDataEnd,
+            Trailer,
+            Done,
+            Error
+        };
+
+        // ϢʼƫƣƶȻЧ
+        struct Span {
+            uint32_t offset = 0;
+            uint32_t length = 0;
+        };
+
+        struct HeaderSpan {
+            Span name;
+            Span value;
+        };
+
+        static constexpr size_t kMaxChunkLine = 1024;
+
+        State state_ = State::StartLine;
+        const char* base_ = nullptr;
+        size_t pos_ = 0;            // һɨ軻з
+        size_t line_start_ = 0;     // ǰе
+        size_t head_length_ = 0;
+        std::vector<HeaderSpan> headers_;
+        uint64_t content_length_ = 0;
+        uint64_t remaining_ = 0;    // ǰϢֿʣֽ
+        bool has_content_length_ = false;
+        bool chunked_ = false;
+        bool close_delimited_ = false;
+
+        // ù״̬ѷ
+        void reset_message() {
+            state_ = State::StartLine;
+            base_ = nullptr;
+            pos_ = 0;
+            line_start_ = 0;
+            head_length_ = 0;
+            headers_.clear();
+            content_length_ = 0;
+            remaining_ = 0;
+            has_content_length_ = false;
+            chunked_ = false;
+            close_delimited_ = false;
+        }
+
+        std::string_view view(Span s) const {
+            return base_ ? std::string_view(base_ + s.offset, s.length) : std::string_view();
+        }
+
+        static Span make_span(size_t begin, size_t end) {
+            return Span{ static_cast<uint32_t>(begin), static_cast<uint32_t>(end - begin) };
+        }
+
+        ParseStatus fail() {
+            state_ = State::Error;
+            return ParseStatus::Error;
+        }
+
+    private:
+        Derived& derived() { return static_cast<Derived&>(*this); }
+
+        // field-name ":" OWS field-value OWS
+        bool parse_header_line(size_t begin, size_t end) {
+            const char* line = base_ + begin;
+            size_t len = end - begin;
+
+            // ֶвֿհףͬʱܾѷд˵һеķָ ':'
+            const char* colon = scan::find_first_of(line, line + len, ": \t");
+            if (colon == line + len || *colon != ':' || colon == line) return false;
+            size_t name_end = static_cast<size_t>(colon - line);
+
+            size_t value_begin = name_end + 1;
+            while (value_begin < len && (line[value_begin] == ' ' || line[value_begin] == '\t')) ++value_begin;
+            size_t value_end = len;
+            while (value_end > value_begin && (line[value_end - 1] == ' ' || line[value_end - 1] == '\t')) --value_end;
+
+            headers_.push_back(HeaderSpan{ make_span(begin, begin + name_end),
+                make_span(begin + value_begin, begin + value_end) });
+            return true;
+        }
+
+        //  Content-Length / Transfer-Encoding ȷϢı߽磬ûгʱ
+        bool finish_headers() {
+            bool has_transfer_encoding = false;
+            bool last_chunked = false;      // бһ chunked
+            size_t chunked_count = 0;
+            for (const auto& header : headers_) {
+                std::string_view name = view(header.name);
+                std::string_view value = view(header.value);
+                if (iequals(name, "Content-Length")) {
+                    uint64_t length = 0;
+                    if (!parse_decimal(value, length)) return false;
+                    if (has_content_length_ && length != content_length_) return false;
+                    content_length_ = length;
+                    has_content_length_ = true;
+                }
+                else if (iequals(name, "Transfer-Encoding")) {
+                    // ֶΰ˳ƴһŷָбȽϣֻ׺"xchunked"  chunked
+                    has_transfer_encoding = true;
+                    bool empty = true;
+                    while (!value.empty()) {
+                        size_t comma = value.find(',');
+                        std::string_view token = trim_ows(value.substr(0, comma));
+                        value = comma == std::string_view::npos ? std::string_view() : value.substr(comma + 1);
+                        if (token.empty()) continue;
+                        empty = false;
+                        last_chunked = iequals(token, "chunked");
+                        if (last_chunked) ++chunked_count;
+                    }
+                    if (empty) return false;
+                }
+            }
+
+            if (has_transfer_encoding) {
+                // ֻ֧һΪ chunked ֻһεĴ룻
+                // ͬʱ Content-Length ˽ĵֱַΪ
+                if (!last_chunked || chunked_count != 1 || has_content_length_) return false;
+                chunked_ = true;
+            }
+
+            if (!derived().has_body()) {
+                content_length_ = 0;
+                state_ = State::Done;
+            }
+            else if (chunked_) {
+                content_length_ = 0;
+                state_ = State::ChunkSize;
+            }
+            else if (has_content_length_) {
+                remaining_ = content_length_;
+                state_ = content_length_ > 0 ? State::Body : State::Done;
+            }
+            else if (derived().close_delimited_by_default()) {
+                close_delimited_ = true;
+                state_ = State::UntilClose;
+            }
+            else {
+                state_ = State::Done;
+            }
+            return true;
+        }
+
+        bool parse_chunk_size(const char* begin, const char* nl) {
+            uint64_t size = 0;
+            const char* p = begin;
+            int digits = 0;
+            for (; p < nl; ++p) {
+                int v;
+                char c = *p;
+                if (c >= '0' && c <= '9') v = c - '0';
+                else if (c >= 'a' && c <= 'f') v = c - 'a' + 10;
+                else if (c >= 'A' && c <= 'F') v = c - 'A' + 10;
+                else break;
+                if (++digits > 15) return false;
+                size = (size << 4) | static_cast<uint64_t>(v);
+            }
+            if (digits == 0) return false;
+            // ֻǷֿչβ
+            if (p < nl && *p != ';' && *p != '\r' && *p != ' ' && *p != '\t') return false;
+            remaining_ = size;
+            return true;
+        }
+
+        static bool parse_decimal(std::string_view value, uint64_t& out) {
+            if (value.empty() || value.size() > 18) return false;
+            uint64_t result = 0;
+            for (char c : value) {
+                if (c < '0' || c > '9') return false;
+                result = result * 10 + static_cast<uint64_t>(c - '0');
+            }
+            out = result;
+            return true;
+        }
+
+        // ȥ˵ĿոƱ
+        static std::string_view trim_ows(std::string_view value) {
+            while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) value.remove_prefix(1);
+            while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) value.remove_suffix(1);
+            return value;
+        }
+    };
+
+    // ʽ HTTP û Content-Length  chunked ûϢ
+    class RequestParser : public MessageParser<RequestParser> {
+        friend class MessageParser<RequestParser>;
+
+    public:
+        RequestParser() { reset(); }
+
+        // Ϊʼ״̬ѷ
+        void reset() {
+            reset_message();
+            method_ = target_ = version_ = Span{};
+        }
+
+        std::string_view method() const { return view(method_); }
+        std::string_view target() const { return view(target_); }
+        std::string_view version() const { return view(version_); }
+
+    private:
+        Span method_;
+        Span target_;
+        Span version_;
+
+        bool has_body() const { return true; }
+        bool close_delimited_by_default() const { return false; }
+
+        // METHOD SP request-target SP HTTP-version
+        bool parse_start_line(size_t begin, size_t end) {
+            const char* line = base_ + begin;
+            size_t len = end - begin;
+
+            const char* line_end = line + len;
+            const char* sp1 = scan::find_first_of(line, line_end, " ");
+            if (sp1 == line_end || sp1 == line) return false;
+            size_t method_end = static_cast<size_t>(sp1 - line);
+
+            size_t target_begin = method_end + 1;
+            const char* sp2 = scan::find_first_of(line + target_begin, line_end, " ");
+            if (sp2 == line_end || sp2 == line + target_begin) return false;
+            size_t target_end = static_cast<size_t>(sp2 - line);
+
+            std::string_view version(line + target_end + 1, len - target_end - 1);
+            if (version.size() != 8 || version.substr(0, 7) != "HTTP/1.") return false;
+
+            method_ = make_span(begin, begin + method_end);
+            target_ = make_span(begin + target_begin, begin + target_end);
+            version_ = make_span(begin + target_end + 1, end);
+            return true;
+        }
+    };
+
+    // ʽ HTTP ӦHEAD ӦԼ 1xx/204/304 ûϢ壻
+    // û Content-Length Ҳ chunked ӦӹرΪ磬ʱڶ EOF  finish()
+    class ResponseParser : public MessageParser<ResponseParser> {
+        friend class MessageParser<ResponseParser>;
+
+    public:
+        ResponseParser() { reset(); }
+
+        // Ϊʼ״̬head_request ʾӦ HEAD
+        void reset(bool head_request = false) {
+            reset_message();
+            version_ = reason_ = Span{};
+            status_ = 0;
+            head_request_ = head_request;
+        }
+
+        int status() const { return status_; }
+        std::string_view version() const { return view(version_); }
+        std::string_view reason() const { return view(reason_); }
+
+        // ӦܷʹãHTTP/1.1 Ĭϱ֣HTTP/1.0 Ҫʽ keep-alive
+        bool keep_alive() const {
+            if (close_delimited_) return false;
+            bool http10 = view(version_) == "HTTP/1.0";
+            for (const auto& header : headers_) {
+                if (iequals(view(header.name), "Connection")) {
+                    std::string_view value = view(header.value);
+                    if (iequals(value, "close")) return false;
+                    if (iequals(value, "keep-alive")) return true;
+                }
+            }
+            return !http10;
+        }
+
+    private:
+        Span version_;
+        Span reason_;
+        int status_ = 0;
+        bool head_request_ = false;
+
+        bool has_body() const {
+            return !head_request_ && status_ >= 200 && status_ != 204 && status_ != 304;
+        }
+        bool close_delimited_by_default() const { return true; }
+
+        // HTTP-version SP 3DIGIT SP [ reason-phrase ]
+        bool parse_start_line(size_t begin, size_t end) {
+            const char* line = base_ + begin;
+            size_t len = end - begin;
+            if (len < 12 || std::string_view(line, 7) != "HTTP/1." || line[8] != ' ') return false;
+            if (len > 12 && line[12] != ' ') return false;
+
+            int status = 0;
+            for (size_t i = 9; i < 12; ++i) {
+                if (line[i] < '0' || line[i] > '9') return false;
+                status = status * 10 + (line[i] - '0');
+            }
+            status_ = status;
+            version_ = make_span(begin, begin + 8);
+            reason_ = len > 13 ? make_span(begin + 13, end) : make_span(end, end);
+            return true;
+        }
+    };
+
+} // namespace http_asio
+
+#endif // HTTP_PARSER_HPP
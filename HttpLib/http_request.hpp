@@ -4,24 +4,90 @@
 
 
 #include "http_types.hpp"
+#include "http_util.hpp"
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <optional>
 #include <sstream>
+#include <array>
+#include <cstdint>
 
 
 namespace http_asio {
 
+// ·ɲ·ֵƫ¼ Request::Path У
+// ָ·ɱ˲ʱڴ棬Request ƶȻЧ
+class PathParamList {
+public:
+    static constexpr size_t kMaxParams = 8;
+
+    void clear() { size_ = 0; }
+
+    bool push(std::string_view name, size_t offset, size_t length) {
+        if (size_ == kMaxParams) return false;
+        items_[size_++] = Item{ name, static_cast<uint32_t>(offset), static_cast<uint32_t>(length) };
+        return true;
+    }
+
+    void pop() {
+        if (size_ > 0) --size_;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    std::string_view name(size_t i) const { return items_[i].name; }
+
+    std::string_view value(const std::string& path, size_t i) const {
+        return std::string_view(path).substr(items_[i].offset, items_[i].length);
+    }
+
+    std::optional<std::string_view> find(const std::string& path, std::string_view name) const {
+        for (size_t i = 0; i < size_; ++i) {
+            if (items_[i].name == name) return value(path, i);
+        }
+        return std::nullopt;
+    }
+
+private:
+    struct Item {
+        std::string_view name;
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+
+    std::array<Item, kMaxParams> items_{};
+    size_t size_ = 0;
+};
+
 class Request {
 public:
     HttpMethod Method = HttpMethod::UNKNOWN;
     std::string Path;
+    std::string Version;
     Param Params;
+    PathParamList PathParams;
     Header Headers;
     std::string Body;
 
     Request() = default;
 
+    // ͷͲѯ resource 
+    explicit Request(std::pmr::memory_resource* resource)
+        : Params(resource), Headers(resource) {}
+
+    // ֶεѷӸ Request 
+    void clear() {
+        Method = HttpMethod::UNKNOWN;
+        Path.clear();
+        Version.clear();
+        Params.clear();
+        PathParams.clear();
+        Headers.clear();
+        Body.clear();
+    }
+
 	void setMethod(const std::string& method) {
 		Method = stringToHttpMethod(method);
 	}
@@ -41,21 +107,51 @@ public:
     }
 
 
-    // ӵͷֶ
-    void addHeader(const std::string& key, const std::string& value) {
-        Headers[key] = value;
+    // ȡ·ɲ· "/users/:id" е id
+    std::optional<std::string_view> getPathParam(std::string_view name) const {
+        return PathParams.find(Path, name);
     }
 
-    // Ƿĳͷֶ
-    bool hasHeader(const std::string& key) const {
-        return Headers.find(key) != Headers.end();
+    // Ŀ꣺'?' ֮ǰΪ Path֮Ĳѯַ Params
+    void setTarget(std::string_view target) {
+        size_t question = target.find('?');
+        Path.assign(target.substr(0, question));
+        if (question != std::string_view::npos) {
+            parseQuery(target.substr(question + 1));
+        }
     }
 
-    // ȡͷֶεֵ
-    std::optional<std::string> getHeaderValue(const std::string& key) const {
-        auto it = Headers.find(key);
-        if (it != Headers.end()) {
-            return it->second;
+    //  "a=1&b=2" ʽĲѯַ
+    void parseQuery(std::string_view query) {
+        while (!query.empty()) {
+            size_t amp = query.find('&');
+            std::string_view pair = query.substr(0, amp);
+            if (!pair.empty()) {
+                size_t eq = pair.find('=');
+                std::string key = url_decode(std::string(pair.substr(0, eq)), true);
+                std::string value = eq == std::string_view::npos ? std::string() : url_decode(std::string(pair.substr(eq + 1)), true);
+                Params[std::move(key)] = std::move(value);
+            }
+            if (amp == std::string_view::npos) break;
+            query.remove_prefix(amp + 1);
+        }
+    }
+
+    // ӵͷֶΣֶͬʱԭе
+    void addHeader(std::string_view key, std::string_view value) {
+        Headers.add(key, value);
+    }
+
+    // ǷĳͷֶΣԴСд
+    bool hasHeader(std::string_view key) const {
+        return Headers.has(key);
+    }
+
+    // ȡͷֶεֵжֶͬʱصһ
+    std::optional<std::string> getHeaderValue(std::string_view key) const {
+        auto value = Headers.get(key);
+        if (value) {
+            return std::string(*value);
         }
         return std::nullopt;
     }
@@ -2,6 +2,7 @@
 #define HTTP_RESPONSE_HPP
 
 #include "http_types.hpp"
+#include "http_content.hpp"
 #include <iostream>
 #include <string>
 #include <string_view>
@@ -12,6 +13,8 @@
 namespace http_asio {
 
     class Response {
+        friend class Session;   // Session ȡʽӦ provider
+
     public:
         StatusCode StatCde = StatusCode::OK;        // Ĭ״̬Ϊ200 OK
         std::string StatusMsg = "OK";               // Ĭ״̬Ϣ
@@ -19,45 +22,101 @@ namespace http_asio {
         std::string Body;                           // Ӧ
 
         Response() = default;
+        // ͷ resource 
+        explicit Response(std::pmr::memory_resource* resource)
+            : Headers(resource) {}
         Response(StatusCode code, const std::string& message)
             : StatCde(code), StatusMsg(message) {}
         Response(StatusCode code, Header head, std::string body)
             : StatCde(code), Headers(head), Body(body) {}
 
-        // ӵͷֶ
-        void SetHeader(const std::string& key, const std::string& value) {
-            Headers[key] = value;
+        // ָΪĬϵ 200 OK Ӧѷ
+        void clear() {
+            StatCde = StatusCode::OK;
+            StatusMsg.assign("OK");
+            Headers.clear();
+            Body.clear();
+            contentLength_ = 0;
+            contentProvider_ = nullptr;
+            chunkedContentProvider_ = nullptr;
+            contentProviderResourceReleaser_ = nullptr;
+        }
+
+        // ͷֶΣ滻еֶͬ
+        void setHeader(std::string_view key, std::string_view value) {
+            Headers.set(key, value);
         }
 
-        // Ƿĳͷֶ
-        bool HasHeader(const std::string& key) const {
-            return Headers.find(key) != Headers.end();
+        // ͷֶΣеֶͬ
+        void addHeader(std::string_view key, std::string_view value) {
+            Headers.add(key, value);
         }
 
-        // ȡͷֶεֵ
-        std::optional<std::string> GetHeaderValue(const std::string& key) const {
-            auto it = Headers.find(key);
-            return it != Headers.end() ? std::make_optional(it->second) : std::nullopt;
+        // ǷĳͷֶΣԴСд
+        bool hasHeader(std::string_view key) const {
+            return Headers.has(key);
+        }
+
+        // ȡͷֶεֵжֶͬʱصһ
+        std::optional<std::string> getHeaderValue(std::string_view key) const {
+            auto value = Headers.get(key);
+            return value ? std::make_optional(std::string(*value)) : std::nullopt;
         }
 
         // ض
-        void SetRedirect(const std::string& location, StatusCode code = StatusCode::Found) {
+        void setRedirect(const std::string& location, StatusCode code = StatusCode::Found) {
             StatCde = code;
-            SetHeader("Location", location);
+            setHeader("Location", location);
             Body.clear(); // ضͨҪ
         }
 
         // Ӧݼ
-        void SetContent(const std::string& content, const std::string& content_type) {
-            Body = content;
-            SetHeader("Content-Type", content_type);
-            SetHeader("Content-Length", std::to_string(content.size()));
+        void setContent(std::string_view content, std::string_view content_type) {
+            Body.assign(content);
+            setHeader("Content-Type", content_type);
+            setHeader("Content-Length", std::to_string(content.size()));
+        }
+
+        // öʽӦ壺socket дʱ provider(offset, max_size, sink)
+        // provider ͨ sink д offset ʼ max_size ݣĳεûдʱӱرա
+        // ӦӶϿ resource_releaser
+        void setContentProvider(size_t length, const std::string& content_type, ContentProvider provider,
+            std::function<void()> resource_releaser = nullptr) {
+            setHeader("Content-Type", content_type);
+            Body.clear();
+            contentLength_ = length;
+            contentProvider_ = std::move(provider);
+            chunkedContentProvider_ = nullptr;
+            contentProviderResourceReleaser_ = std::move(resource_releaser);
+        }
+
+        //  chunked 뷢͵ʽӦ壺 provider(chunk_size, sink)provider ͨ sink дһݣ
+        // ĳεûдݱʾһд socket ֮Żٴε providerڴռӦܳ޹
+        void setChunkedContentProvider(const std::string& content_type, ChunkedContentProvider provider,
+            std::function<void()> resource_releaser = nullptr) {
+            setHeader("Content-Type", content_type);
+            Body.clear();
+            contentLength_ = 0;
+            contentProvider_ = nullptr;
+            chunkedContentProvider_ = std::move(provider);
+            contentProviderResourceReleaser_ = std::move(resource_releaser);
+        }
+
+        bool hasContentProvider() const {
+            return contentProvider_ || chunkedContentProvider_;
         }
 
         // ״̬״̬Ϣ
-        void SetStatus(StatusCode code, const std::string& message = "") {
+        void setStatus(StatusCode code, const std::string& message = "") {
             StatCde = code;
-            StatusMsg = message;
+            if (message.empty()) {
+                // δָʱʹñ׼ԭ״̬ȱ
+                std::string text = statusCodeToString(code);
+                StatusMsg = text.substr(text.find(' ') + 1);
+            }
+            else {
+                StatusMsg = message;
+            }
         }
 
         // Cookie
@@ -71,25 +130,25 @@ namespace http_asio {
             if (domain) cookie << "; Domain=" << *domain;
             if (http_only) cookie << "; HttpOnly";
             if (secure) cookie << "; Secure";
-            SetHeader("Set-Cookie", cookie.str());
+            addHeader("Set-Cookie", cookie.str());  // ÿ Cookie һ Set-Cookie ֶ
         }
 
         // ĳͷֶ
-        void removeHeader(const std::string& key) {
-            Headers.erase(key);
+        void removeHeader(std::string_view key) {
+            Headers.remove(key);
         }
 
         // 
         void enableCORS(const std::string& origin = "*", const std::string& methods = "GET, POST, PUT, DELETE") {
-            SetHeader("Access-Control-Allow-Origin", origin);
-            SetHeader("Access-Control-Allow-Methods", methods);
+            setHeader("Access-Control-Allow-Origin", origin);
+            setHeader("Access-Control-Allow-Methods", methods);
         }
 
         // ѹ ӿ
         void setCompressedContent(const std::string& compressed_data, const std::string& compression_type) {
             Body = compressed_data;
-            SetHeader("Content-Encoding", compression_type);
-            SetHeader("Content-Length", std::to_string(compressed_data.size()));
+            setHeader("Content-Encoding", compression_type);
+            setHeader("Content-Length", std::to_string(compressed_data.size()));
         }
 
         // ӦתΪԭʼӦַ
@@ -114,6 +173,7 @@ namespace http_asio {
 
         size_t contentLength_ = 0;
         ContentProvider contentProvider_;
+        ChunkedContentProvider chunkedContentProvider_;
         std::function<void()> contentProviderResourceReleaser_;
     };
 
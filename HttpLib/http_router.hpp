@@ -0,0 +1,336 @@
+#ifndef HTTP_ROUTER_HPP
+#define HTTP_ROUTER_HPP
+
+#include "http_types.hpp"
+#include "http_request.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace http_asio {
+
+    template <typename T> class Router;
+    template <typename T> class RouteTable;
+
+    namespace detail {
+        constexpr size_t kMethodCount = static_cast<size_t>(HttpMethod::UNKNOWN) + 1;
+    }
+
+    // ѹǰ׺radix tree·ɣȰ HttpMethod ٰ·ַƥ䡣
+    // ģʽ﷨
+    //   /users/:id          ":name" ƥһ·Σ '/'
+    //   /static/*filepath   "*name" ƥʣȫ·ֻܳĩβ
+    // ƥȼ̬ >  > ͨΡƥʱֻ·йأ·޹ء
+    // Router ǿ޸ĵĹעɺͨ freeze() õֻ RouteTable ƥ䡣
+    template <typename T>
+    class Router {
+        static constexpr size_t kMethodCount = detail::kMethodCount;
+
+    public:
+        Router() = default;
+        Router(const Router&) = delete;
+        Router& operator=(const Router&) = delete;
+        Router(Router&&) = default;
+        Router& operator=(Router&&) = default;
+
+        //  (method, pattern) ӦֵʱĬֵ
+        // κͨκϼƳ PathParamList::kMaxParams ʱ׳ std::invalid_argument޸
+        T& emplace(HttpMethod method, std::string_view pattern) {
+            if (count_params(pattern) > PathParamList::kMaxParams) {
+                throw std::invalid_argument("too many parameters in route: " + std::string(pattern));
+            }
+            Node* node = &roots_[index(method)];
+            size_t i = 0;
+            while (i < pattern.size()) {
+                char c = pattern[i];
+                if (c == ':') {
+                    size_t end = pattern.find('/', i);
+                    if (end == std::string_view::npos) end = pattern.size();
+                    node = child_param(node, pattern.substr(i + 1, end - i - 1), pattern);
+                    i = end;
+                }
+                else if (c == '*') {
+                    node = child_wildcard(node, pattern.substr(i + 1), pattern);
+                    i = pattern.size();
+                }
+                else {
+                    size_t end = pattern.find_first_of(":*", i);
+                    if (end == std::string_view::npos) end = pattern.size();
+                    node = insert_static(node, pattern.substr(i, end - i));
+                    i = end;
+                }
+            }
+            if (!node->value) {
+                node->value.emplace();
+                ++size_;
+            }
+            return *node->value;
+        }
+
+        // Ϊɱıƽ·ɱֲ䣬ɼ޸ĺٴζ
+        std::shared_ptr<const RouteTable<T>> freeze() const {
+            auto table = std::make_shared<RouteTable<T>>();
+            for (size_t m = 0; m < kMethodCount; ++m) {
+                table->roots_[m] = table->flatten(roots_[m]);
+            }
+            return table;
+        }
+
+        size_t size() const { return size_; }
+
+    private:
+        friend class RouteTable<T>;
+
+        struct Node {
+            std::string prefix;                             // ̬ڵѹǰ׺
+            std::string indices;                            // ̬ӽڵǰ׺ַ children һһӦ
+            std::vector<std::unique_ptr<Node>> children;    // ̬ӽڵ
+            std::unique_ptr<Node> param_child;              // ":name" ӽڵ
+            std::unique_ptr<Node> wildcard_child;           // "*name" ӽڵ
+            std::string name;                               // ͨڵĲ
+            std::optional<T> value;
+        };
+
+        std::array<Node, kMethodCount> roots_;
+        size_t size_ = 0;
+
+        static size_t index(HttpMethod method) {
+            return static_cast<size_t>(method);
+        }
+
+        //  emplace ͬķʽз patternͳ ":name"  "*name" εĸ
+        static size_t count_params(std::string_view pattern) {
+            size_t count = 0;
+            size_t i = pattern.find_first_of(":*");
+            while (i != std::string_view::npos) {
+                ++count;
+                if (pattern[i] == '*') break;
+                i = pattern.find('/', i);
+                if (i != std::string_view::npos) i = pattern.find_first_of(":*", i);
+            }
+            return count;
+        }
+
+        static Node* insert_static(Node* node, std::string_view s) {
+            while (!s.empty()) {
+                size_t pos = node->indices.find(s[0]);
+                if (pos == std::string::npos) {
+                    auto child = std::make_unique<Node>();
+                    child->prefix.assign(s);
+                    Node* raw = child.get();
+                    node->indices.push_back(s[0]);
+                    node->children.push_back(std::move(child));
+                    return raw;
+                }
+
+                Node* child = node->children[pos].get();
+                size_t common = 0;
+                while (common < s.size() && common < child->prefix.size() && s[common] == child->prefix[common]) {
+                    ++common;
+                }
+
+                if (common < child->prefix.size()) {
+                    // ֣ǰ׺Ϊµмڵ
+                    auto mid = std::make_unique<Node>();
+                    mid->prefix = child->prefix.substr(0, common);
+                    child->prefix.erase(0, common);
+                    mid->indices.push_back(child->prefix[0]);
+                    mid->children.push_back(std::move(node->children[pos]));
+                    node->children[pos] = std::move(mid);
+                    child = node->children[pos].get();
+                }
+
+                node = child;
+                s.remove_prefix(common);
+            }
+            return node;
+        }
+
+        static Node* child_param(Node* node, std::string_view name, std::string_view pattern) {
+            if (name.empty()) {
+                throw std::invalid_argument("empty parameter name in route: " + std::string(pattern));
+            }
+            if (!node->param_child) {
+                node->param_child = std::make_unique<Node>();
+                node->param_child->name.assign(name);
+            }
+            else if (node->param_child->name != name) {
+                throw std::invalid_argument("conflicting parameter name in route: " + std::string(pattern));
+            }
+            return node->param_child.get();
+        }
+
+        static Node* child_wildcard(Node* node, std::string_view name, std::string_view pattern) {
+            if (name.empty() || name.find('/') != std::string_view::npos) {
+                throw std::invalid_argument("wildcard must be the last segment of route: " + std::string(pattern));
+            }
+            if (!node->wildcard_child) {
+                node->wildcard_child = std::make_unique<Node>();
+                node->wildcard_child->name.assign(name);
+            }
+            else if (node->wildcard_child->name != name) {
+                throw std::invalid_argument("conflicting wildcard name in route: " + std::string(pattern));
+            }
+            return node->wildcard_child.get();
+        }
+    };
+
+    // ֻ·ɱнڵ㡢ӽڵֱַУ
+    // ƥʱֻ±ʣԻѺá޸ģɱ̡߳ͬʱ
+    // Ĳƫʽд Request::PathParamsָ򱾱ڴ档
+    template <typename T>
+    class RouteTable {
+    public:
+        // ƥ·ɣʧܷ nullptrparams м¼Ĳ
+        const T* find(HttpMethod method, std::string_view path, PathParamList& params) const {
+            params.clear();
+            int32_t root = roots_[static_cast<size_t>(method)];
+            if (root < 0) return nullptr;
+            return lookup(static_cast<uint32_t>(root), path, path.size(), params);
+        }
+
+        size_t size() const { return values_.size(); }
+
+    private:
+        friend class Router<T>;
+
+        struct FlatNode {
+            uint32_t prefix_offset = 0;     //  chars_ еλ
+            uint32_t prefix_length = 0;
+            uint32_t name_offset = 0;       //  chars_ еλ
+            uint32_t name_length = 0;
+            uint32_t children_begin = 0;    // ̬ӽڵ children_ / child_chars_ е
+            uint32_t children_count = 0;
+            int32_t param_child = -1;
+            int32_t wildcard_child = -1;
+            int32_t value = -1;             //  values_ е±
+        };
+
+        std::array<int32_t, detail::kMethodCount> roots_{};
+        std::vector<FlatNode> nodes_;
+        std::vector<uint32_t> children_;
+        std::string child_chars_;           // ̬ӽڵǰ׺ַ
+        std::string chars_;                 // ǰ׺
+        std::vector<T> values_;
+
+        std::string_view chars(uint32_t offset, uint32_t length) const {
+            return std::string_view(chars_).substr(offset, length);
+        }
+
+        // չֵܽڵ children_ 
+        template <typename Node>
+        int32_t flatten(const Node& node) {
+            int32_t id = static_cast<int32_t>(nodes_.size());
+            nodes_.emplace_back();
+            {
+                FlatNode& flat = nodes_[id];
+                flat.prefix_offset = static_cast<uint32_t>(chars_.size());
+                flat.prefix_length = static_cast<uint32_t>(node.prefix.size());
+                chars_ += node.prefix;
+                flat.name_offset = static_cast<uint32_t>(chars_.size());
+                flat.name_length = static_cast<uint32_t>(node.name.size());
+                chars_ += node.name;
+                if (node.value) {
+                    flat.value = static_cast<int32_t>(values_.size());
+                    values_.push_back(*node.value);
+                }
+            }
+
+            uint32_t begin = static_cast<uint32_t>(children_.size());
+            children_.resize(children_.size() + node.children.size());
+            child_chars_ += node.indices;
+            nodes_[id].children_begin = begin;
+            nodes_[id].children_count = static_cast<uint32_t>(node.children.size());
+            for (size_t i = 0; i < node.children.size(); ++i) {
+                children_[begin + i] = static_cast<uint32_t>(flatten(*node.children[i]));
+            }
+            if (node.param_child) {
+                int32_t child = flatten(*node.param_child);
+                nodes_[id].param_child = child;
+            }
+            if (node.wildcard_child) {
+                int32_t child = flatten(*node.wildcard_child);
+                nodes_[id].wildcard_child = child;
+            }
+            return id;
+        }
+
+        // path ΪδƥĲ֣total Ϊ·ȣڼƫ
+        const T* lookup(uint32_t id, std::string_view path, size_t total, PathParamList& params) const {
+            const FlatNode& node = nodes_[id];
+            if (path.empty() && node.value >= 0) {
+                return &values_[node.value];
+            }
+
+            if (!path.empty()) {
+                std::string_view first(child_chars_.data() + node.children_begin, node.children_count);
+                size_t pos = first.find(path[0]);
+                if (pos != std::string_view::npos) {
+                    uint32_t child_id = children_[node.children_begin + pos];
+                    const FlatNode& child = nodes_[child_id];
+                    std::string_view prefix = chars(child.prefix_offset, child.prefix_length);
+                    if (path.compare(0, prefix.size(), prefix) == 0) {
+                        if (const T* found = lookup(child_id, path.substr(prefix.size()), total, params)) {
+                            return found;
+                        }
+                    }
+                }
+
+                if (node.param_child >= 0) {
+                    const FlatNode& param = nodes_[node.param_child];
+                    size_t end = path.find('/');
+                    if (end == std::string_view::npos) end = path.size();
+                    if (end > 0 && params.push(chars(param.name_offset, param.name_length), total - path.size(), end)) {
+                        if (const T* found = lookup(static_cast<uint32_t>(node.param_child), path.substr(end), total, params)) {
+                            return found;
+                        }
+                        params.pop();
+                    }
+                }
+            }
+
+            if (node.wildcard_child >= 0) {
+                const FlatNode& wildcard = nodes_[node.wildcard_child];
+                if (wildcard.value >= 0
+                    && params.push(chars(wildcard.name_offset, wildcard.name_length), total - path.size(), path.size())) {
+                    return &values_[wildcard.value];
+                }
+            }
+            return nullptr;
+        }
+    };
+
+    // ·ɱķ㣨RCU 񣩣д߹±滻ذ汾Żա
+    // ڴоɱ shared_ptrֱͷţ֮󿴵±
+    template <typename T>
+    class RouteTableSlot {
+    public:
+        void publish(std::shared_ptr<const RouteTable<T>> table) {
+            table_.store(std::move(table), std::memory_order_release);
+            version_.fetch_add(1, std::memory_order_release);
+        }
+
+        // չʱˢ£ֻȡһΰ汾
+        void refresh(std::shared_ptr<const RouteTable<T>>& cached, uint64_t& cached_version) const {
+            uint64_t version = version_.load(std::memory_order_acquire);
+            if (!cached || version != cached_version) {
+                cached = table_.load(std::memory_order_acquire);
+                cached_version = version;
+            }
+        }
+
+    private:
+        std::atomic<std::shared_ptr<const RouteTable<T>>> table_;
+        std::atomic<uint64_t> version_{ 0 };
+    };
+
+} // namespace http_asio
+
+#endif // HTTP_ROUTER_HPP
@@ -0,0 +1,156 @@
+#ifndef HTTP_SCAN_HPP
+#define HTTP_SCAN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// ָɨںˣ HTTP в CR/LF':'ոȷָ
+// x86 ƽ̨ϸʱ⵽ CPU ѡ AVX2ÿ 32 ֽڣ SSE4.2ÿ 16 ֽڣʵ֣
+// ƽ̨ HTTP_ASIO_NO_SIMD ʱʹֽڵıʵ֡
+#if !defined(HTTP_ASIO_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define HTTP_ASIO_SCAN_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define HTTP_ASIO_TARGET(x)
+#else
+#define HTTP_ASIO_TARGET(x) __attribute__((target(x)))
+#endif
+#endif
+
+namespace http_asio {
+namespace scan {
+
+    // ֵ֧ķָ
+    constexpr size_t kMaxDelimiters = 8;
+
+    using FindFn = const char* (*)(const char* p, const char* end, const char* set, size_t set_size);
+
+    namespace detail {
+
+        inline const char* find_scalar(const char* p, const char* end, const char* set, size_t set_size) {
+            for (; p < end; ++p) {
+                for (size_t i = 0; i < set_size; ++i) {
+                    if (*p == set[i]) return p;
+                }
+            }
+            return end;
+        }
+
+#ifdef HTTP_ASIO_SCAN_X86
+        inline unsigned count_trailing_zeros(uint32_t mask) {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+        }
+
+        // SSE4.2PCMPESTRI һָ 16 ֽƥһָ
+        HTTP_ASIO_TARGET("sse4.2")
+        inline const char* find_sse42(const char* p, const char* end, const char* set, size_t set_size) {
+            alignas(16) char needles[16] = {};
+            std::memcpy(needles, set, set_size);
+            const __m128i needle = _mm_load_si128(reinterpret_cast<const __m128i*>(needles));
+            const int needle_len = static_cast<int>(set_size);
+
+            while (end - p >= 16) {
+                __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                int index = _mm_cmpestri(needle, needle_len, data, 16,
+                    _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_LEAST_SIGNIFICANT);
+                if (index < 16) return p + index;
+                p += 16;
+            }
+            return find_scalar(p, end, set, set_size);
+        }
+
+        // AVX2ÿָ㲥һȽϺϲ
+        HTTP_ASIO_TARGET("avx2")
+        inline const char* find_avx2(const char* p, const char* end, const char* set, size_t set_size) {
+            __m256i needles[kMaxDelimiters];
+            for (size_t i = 0; i < set_size; ++i) {
+                needles[i] = _mm256_set1_epi8(set[i]);
+            }
+
+            while (end - p >= 32) {
+                __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+                __m256i hit = _mm256_cmpeq_epi8(data, needles[0]);
+                for (size_t i = 1; i < set_size; ++i) {
+                    hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(data, needles[i]));
+                }
+                uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hit));
+                if (mask != 0) return p + count_trailing_zeros(mask);
+                p += 32;
+            }
+            return find_scalar(p, end, set, set_size);
+        }
+
+        inline bool cpu_has_avx2() {
+#if defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7) return false;
+            __cpuid(info, 1);
+            bool osxsave = (info[2] & (1 << 27)) != 0;
+            bool avx = (info[2] & (1 << 28)) != 0;
+            if (!osxsave || !avx) return false;
+            // ϵͳҪ YMM Ĵ״̬
+            if ((_xgetbv(0) & 0x6) != 0x6) return false;
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            return __builtin_cpu_supports("avx2");
+#endif
+        }
+
+        inline bool cpu_has_sse42() {
+#if defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 1);
+            return (info[2] & (1 << 20)) != 0;
+#else
+            return __builtin_cpu_supports("sse4.2");
+#endif
+        }
+#endif // HTTP_ASIO_SCAN_X86
+
+        inline FindFn select_find() {
+#ifdef HTTP_ASIO_SCAN_X86
+            if (cpu_has_avx2()) return find_avx2;
+            if (cpu_has_sse42()) return find_sse42;
+#endif
+            return find_scalar;
+        }
+
+        // ״ʹʱһ CPU 
+        inline FindFn find_impl() {
+            static const FindFn fn = select_find();
+            return fn;
+        }
+
+    } // namespace detail
+
+    //  [p, end) вҵһ set ַҲʱ endset  kMaxDelimiters ַ
+    inline const char* find_first_of(const char* p, const char* end, const char* set, size_t set_size) {
+        if (p >= end) return end;
+        return detail::find_impl()(p, end, set, set_size);
+    }
+
+    template <size_t N>
+    inline const char* find_first_of(const char* p, const char* end, const char (&set)[N]) {
+        static_assert(N - 1 > 0 && N - 1 <= kMaxDelimiters, "delimiter set size out of range");
+        return find_first_of(p, end, set, N - 1);
+    }
+
+    // β '\n'
+    inline const char* find_line_end(const char* p, const char* end) {
+        return find_first_of(p, end, "\n");
+    }
+
+} // namespace scan
+} // namespace http_asio
+
+#endif // HTTP_SCAN_HPP
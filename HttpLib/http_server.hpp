@@ -6,6 +6,16 @@
 #include "http_request.hpp"
 #include "http_asio_wrapper.hpp"
 #include "http_util.hpp"
+#include "http_parser.hpp"
+#include "http_content.hpp"
+#include "http_router.hpp"
+#include "http_arena.hpp"
+#include "http_file.hpp"
+#include "http_asset_cache.hpp"
+#include "http_thread_pool.hpp"
+#include "http_timer_wheel.hpp"
+#include "http_admission.hpp"
+#include "const.hpp"
 
 #include <asio.hpp>
 #include <string>
@@ -14,8 +24,20 @@
 #include <memory>
 #include <iostream>
 #include <queue>
+#include <deque>
+#include <charconv>
+#include <memory_resource>
+#include <vector>
+#include <string_view>
+#include <span>
+#include <cstring>
 #include <regex>
 #include <map>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <limits>
 
 
 namespace http_asio {
@@ -24,28 +46,124 @@ namespace http_asio {
 	class Session;
 
     using Handler = std::function<void(const Request&, Response&)>;
+    using HandlerWithContentReader = std::function<void(const Request&, Response&, const ContentReader&)>;
+#if defined(ASIO_HAS_CO_AWAIT)
+    // Э̴ co_await 첽ͻˡʱȶ reactor
+    using CoroutineHandler = std::function<asio::awaitable<Response>(Request&)>;
+#endif
+
+    // ·ɴִзʽ
+    enum class ExecutionPolicy {
+        Inline,     // ڵ io ֱִ߳
+        Offload     // ִ̳߳УɺصӵִϷӦ
+    };
+
+    // һ·עĴʽȡĴ
+    struct Route {
+        Handler handler;
+        HandlerWithContentReader content_reader_handler;
+#if defined(ASIO_HAS_CO_AWAIT)
+        CoroutineHandler coroutine_handler;
+#endif
+        ExecutionPolicy policy = ExecutionPolicy::Inline;   // ֻ handler Ч
+        size_t max_pending = 0;                             // Offload ʱŶӺִеޣ0 Ϊޣ 503
+        // ·ɱÿζᶼ´ RouteԱ汾ۼ
+        std::shared_ptr<std::atomic<size_t>> pending = std::make_shared<std::atomic<size_t>>(0);
+    };
+
+
+    // в Server в Session
+    struct ServerConfig {
+        size_t keep_alive_max_count = CPPHTTPLIB_KEEPALIVE_MAX_COUNT;                       // ദ
+        std::chrono::seconds keep_alive_timeout{ CPPHTTPLIB_KEEPALIVE_TIMEOUT_SECOND };     // ӵĳʱʱ
+        std::chrono::milliseconds header_timeout{ CPPHTTPLIB_READ_TIMEOUT_SECOND * 1000 + CPPHTTPLIB_READ_TIMEOUT_USECOND / 1000 };   // ĵһֽͷ
+        std::chrono::milliseconds read_timeout{ CPPHTTPLIB_READ_TIMEOUT_SECOND * 1000 + CPPHTTPLIB_READ_TIMEOUT_USECOND / 1000 };     // ȡʱյݵ
+        std::chrono::milliseconds write_timeout{ CPPHTTPLIB_WRITE_TIMEOUT_SECOND * 1000 + CPPHTTPLIB_WRITE_TIMEOUT_USECOND / 1000 };  // дӦʱдݵ
+        size_t pipeline_max_depth = CPPHTTPLIB_PIPELINE_MAX_DEPTH;                          // δдӦͣȡ
+        size_t payload_max_length = CPPHTTPLIB_PAYLOAD_MAX_LENGTH;                          // 󳤶ȣ 413
+        size_t session_pool_max_size = CPPHTTPLIB_SESSION_POOL_MAX_SIZE;                    // ÿ reactor ໺Ŀ session 
+        std::vector<MountPoint> mount_points;                                               // ̬ļص㣬˳ƥ
+        std::shared_ptr<FileCache> file_cache = std::make_shared<FileCache>();              //  reactor õļ
+        std::shared_ptr<AssetCache> asset_cache;                                            // Сļڴ滺棬Ϊʱ
+        bool compress = true;                                                               //  Accept-Encoding ѹӦ壬 CPPHTTPLIB_ZLIB_SUPPORT
+        int compression_level = -1;                                                         // zlib ѹ-1 ΪĬϼ6
+        size_t compress_min_size = CPPHTTPLIB_COMPRESS_MIN_SIZE;                            // СڸóȵӦ岻ѹ
+        std::shared_ptr<ThreadPool> worker_pool;                                            // Offload ·ɵĹ̳߳
+        size_t max_connections = 0;                                                         // 0 ʾ
+        size_t max_inflight_requests = 0;                                                   // 󲢷0 ʾ
+        OverloadAction overload_action = OverloadAction::Reject;                            // ʱӵĴʽ
+        std::chrono::seconds retry_after{ CPPHTTPLIB_RETRY_AFTER_SECOND };                  // 503 Ӧе Retry-After
+        std::shared_ptr<ConcurrencyLimit> concurrency_limit;                                // Ӧ
+        std::shared_ptr<AdmissionControl> admission;                                        //  Run() ô
+    };
 
     class Session : public std::enable_shared_from_this<Session> {
     public:
         Session(asio::ip::tcp::socket socket, std::shared_ptr<IOContextWrapper> io_context, 
-            std::function<void(Response&)> error_handler, std::weak_ptr<SessionPool> pool)
-			: socket_(std::move(socket)), io_context_(io_context), error_handler_(error_handler), pool_(pool),
-            buffer_(std::make_shared<asio::streambuf>()) {}
+            std::function<void(Response&)> error_handler, std::weak_ptr<SessionPool> pool,
+            std::shared_ptr<const ServerConfig> config, std::shared_ptr<TimerWheel> timer_wheel)
+			: socket_(std::move(socket)), io_context_(io_context), error_handler_(error_handler),
+            request_(&pool_resource_), pool_(pool), config_(config), timer_wheel_(std::move(timer_wheel)),
+            read_timer_([this]() { on_read_timeout(); }), write_timer_([this]() { on_write_timeout(); }),
+            read_buffer_(CPPHTTPLIB_RECV_BUFSIZ), reader_response_(&pool_resource_) {}
 
 		~Session() {
+            cancel_admission();
 			std::cout << "Session destroyed" << std::endl;
 		}
 
         void start() {
+            returned_ = false;
+            io_context_->addConnection();
+            // ӴӽͰͷ޼ʱϺ󲻷ݵͬᱻر
+            timer_wheel_->schedule(read_timer_, config_->header_timeout);
+            header_deadline_ = true;
             read_request();
         }
 
+        // һµȫ״̬ѷ SessionPool 
+        void reset() {
+            request_.clear();
+            reader_response_.clear();
+            body_receiver_ = nullptr;
+            body_decoder_.reset();
+            body_encoded_ = false;
+            route_ = nullptr;
+            reader_route_ = false;
+            body_size_ = 0;
+            request_count_ = 0;
+            read_begin_ = read_end_ = 0;
+            parser_.reset();
+            output_queue_.clear();
+            write_buffers_.clear();
+            writing_count_ = 0;
+            arena_.rewind();
+            reading_ = false;
+            read_paused_ = false;
+            awaiting_ = false;
+            closing_ = false;
+            head_request_ = false;
+            header_deadline_ = false;
+            read_timer_.cancel();
+            write_timer_.cancel();
+            cancel_admission();
+        }
+
         void assignSocket(asio::ip::tcp::socket socket) {
             socket_ = std::move(socket);
         }
 
-        void setHandlerMap(const std::unordered_map<std::string, Handler>& handlers) {
-            handlers_ = handlers;
+        // ֱӽӵ session  socket 
+        asio::ip::tcp::socket& socket() {
+            return socket_;
+        }
+
+        void setErrorHandler(std::function<void(Response&)> handler) {
+            error_handler_ = std::move(handler);
+        }
+
+        void setRoutes(const RouteTableSlot<Route>* routes) {
+            routes_ = routes;
         }
 
         void returnSession();
@@ -54,234 +172,1716 @@ namespace http_asio {
         asio::ip::tcp::socket socket_;
         std::shared_ptr<IOContextWrapper> io_context_;
         std::function<void(Response&)> error_handler_;
+        std::pmr::unsynchronized_pool_resource pool_resource_;  // ͷеĽڵ֮ѭʹ
+        Arena arena_;                                           // лӦ䣬պ
         Request request_;
-        std::unordered_map<std::string, Handler> handlers_;
-        std::shared_ptr<asio::streambuf> buffer_;
+        const RouteTableSlot<Route>* routes_ = nullptr;             //  Server ·ɱ
+        std::shared_ptr<const RouteTable<Route>> route_table_;      // ǰʹõ·ɱ
+        uint64_t route_version_ = 0;
+        const Route* route_ = nullptr;                              // ǰƥ䵽·ɣָ route_table_
         std::weak_ptr<SessionPool> pool_;
-        
-        class Deleter
-        {
-        public:
-            void operator() (asio::streambuf* x) {
-                std::cout << "Deleter function called" << std::endl;
-                delete[] x;
+        std::shared_ptr<const ServerConfig> config_;
+        std::shared_ptr<TimerWheel> timer_wheel_;   //  reactor ʱ
+        TimerEntry read_timer_;                 // СͷĶȡ
+        TimerEntry write_timer_;                // дӦ
+        size_t request_count_ = 0;              // ǰѴ
+        std::vector<char> read_buffer_;         // ӶֱϹ
+        HandlerMemory read_memory_;             //  asio ״̬ͬһʱֻһ
+        HandlerMemory write_memory_;            // д sendfile ȴд asio ״̬
+        size_t read_begin_ = 0;                 // δݵ
+        size_t read_end_ = 0;                   // Ѷݵյ
+        RequestParser parser_;
+        uint64_t body_size_ = 0;                // ǰյֽ
+        bool reader_route_ = false;             // ǰ HandlerWithContentReader 
+        Response reader_response_;              // ʽ·ɵӦ
+        ContentReceiver body_receiver_;         // ʽ·עպ
+        std::unique_ptr<Decompressor> body_decoder_;    //  Content-Encoding ʱĽ
+        bool body_encoded_ = false;             // ǰյҪ
+
+        // ļΪӦʱļ
+        struct FileBody {
+            std::shared_ptr<const OpenFile> file;   // HEAD ʱΪգֻͷ
+            uint64_t offset = 0;
+            uint64_t length = 0;
+        };
+
+        //  ContentProvider / ChunkedContentProvider ɵӦ壬ʱ releaser
+        struct StreamBody {
+            ContentProvider provider;                   // 
+            ChunkedContentProvider chunked_provider;    // δ֪
+            std::function<void()> releaser;
+            std::unique_ptr<Compressor> compressor;     // ʽѹʱ chunked 뷢
+            uint64_t length = 0;                        // ݵܳ
+            uint64_t offset = 0;                        // ɵĳ
+            bool chunked = false;                       //  chunked ֡
+            bool finished = false;
+
+            ~StreamBody() {
+                if (releaser) releaser();
             }
         };
 
+        // ͵Ӧ󵽴˳Ŷ
+        // дʱΪ status_lineheadbody Σbody ֱӦ壬
+        //  file Ӧͷдͨ sendfile ļ
+        struct PendingResponse {
+            std::string_view status_line{};     // Ԥɵľ̬״̬УԶԭʱΪգ״̬д head У
+            std::pmr::string head{};            // ״̬֮ͷ arena_ 
+            std::string body{};                 //  Response Ӧ
+            bool keep_alive = true;
+            FileBody file{};                    // δ͵ļ䣬͹ offset/length ֮ƽ
+            std::shared_ptr<const void> holder{};   //  shared_head / shared_body õĻЧ
+            std::string_view shared_head{};         // AssetCache Ԥɵͷ飬д head ֮ǰ
+            std::string_view shared_body{};         // AssetCache еӦ壬д body ֮
+            std::unique_ptr<StreamBody> stream{};   // ͷдɲдӦ
+        };
+        std::pmr::deque<PendingResponse> output_queue_{ &pool_resource_ };
+        std::vector<asio::const_buffer> write_buffers_;     // ϲдʱʹõ buffer 
+        size_t writing_count_ = 0;                          // дĶӦ
+        std::vector<char> file_buffer_;                     // ֧ sendfile ʱȡļݵĻ
+        std::string stream_raw_;                            // provider ɵ
+        std::string stream_compressed_;                     // ѹĽ
+        std::string stream_buffer_;                         // ֡дݣдٴε provider
+        bool reading_ = false;                              // ǷйĶ
+        bool read_paused_ = false;                          // ͣȡ
+        bool awaiting_ = false;                             // Э̴δɣͣȡʹ
+        bool closing_ = false;                              // ٽдкر
+        bool head_request_ = false;                         // ǰΪ HEADӦֻͷ
+        bool header_deadline_ = false;                      // ǰͷãȡʱ˳
+        bool admitted_ = false;                             // ǰѼ벢Ӧͷ
+        std::chrono::steady_clock::time_point dispatched_at_;   // ǰ󽻸ʱ䣬ӳ
+        bool returned_ = false;                             // ѹ黹 SessionPool
+        
         void read_request() {
+            if (closing_ || reading_ || awaiting_) {
+                if (!reading_) {
+                    stop_read_timer();  // ȴڼ䲻ƶʱ
+                }
+                return;
+            }
+            if (output_queue_.size() >= config_->pipeline_max_depth) {
+                read_paused_ = true;  // ȴдټȡ
+                stop_read_timer();
+                return;
+            }
             auto self(shared_from_this());
-            asio::async_read_until(socket_, *buffer_, "\r\n\r\n",
-                [this, self](std::error_code ec, std::size_t length) { //  buffer
+            reading_ = true;
+            start_read_timer();
+            prepare_read_buffer();
+            socket_.async_read_some(asio::buffer(read_buffer_.data() + read_end_, read_buffer_.size() - read_end_),
+                bind_memory(read_memory_, [this, self](std::error_code ec, std::size_t length) {
+                    reading_ = false;
                     if (!ec) {
-                        parse_request(buffer_);
-                        handle_request();
-                    } else if (ec == asio::error::eof) {  //  End of File 
-                        std::cerr << "Client closed connection" << std::endl;
-                        returnSession();
-                    } else {
-                        std::cerr << "Error during async_read_until: " << ec.message() << std::endl;
+                        read_end_ += length;
+                        process_buffered_requests();
+                        flush_output();
+                        read_request();
+                        return;
+                    }
+                    if (ec != asio::error::eof && ec != asio::error::operation_aborted) {
+                        std::cerr << "Error during async_read_some: " << ec.message() << std::endl;
+                    }
+                    // Զ˹رջʱдŶӵӦͷ session
+                    closing_ = true;
+                    flush_output();
+                    finish_if_idle();
+            }));
+        }
+
+        // Ϊһζȡڳռ䣺ȫλδѵƵͷ
+        void prepare_read_buffer() {
+            if (read_begin_ == read_end_) {
+                read_begin_ = read_end_ = 0;
+            }
+            else if (read_begin_ > 0 && read_end_ == read_buffer_.size()) {
+                std::memmove(read_buffer_.data(), read_buffer_.data() + read_begin_, read_end_ - read_begin_);
+                read_end_ -= read_begin_;
+                read_begin_ = 0;
+            }
+            if (read_end_ == read_buffer_.size()) {
+                read_buffer_.resize(read_buffer_.size() * 2);
+            }
+        }
+
+        // δHTTP/1.1 ߻
+        void process_buffered_requests() {
+            while (!closing_ && !awaiting_) {
+                const char* data = read_buffer_.data() + read_begin_;
+                size_t size = read_end_ - read_begin_;
+
+                if (!parser_.headers_complete()) {
+                    ParseStatus status = parser_.parse(data, size);
+                    if (status == ParseStatus::Incomplete) {
+                        if (size > CPPHTTPLIB_HEADER_MAX_LENGTH) {
+                            head_request_ = false;
+                            send_error_response(StatusCode::RequestHeaderFieldsTooLarge);
+                        }
+                        return;
+                    }
+                    if (status == ParseStatus::Error) {
+                        head_request_ = false;  // δһķ
                         send_error_response(StatusCode::BadRequest);
-                        returnSession();  // ͷ session
+                        return;
+                    }
+                    // ͷһεʱᾭ Incomplete ֧ͬҪܳ
+                    if (parser_.head_length() > CPPHTTPLIB_HEADER_MAX_LENGTH) {
+                        head_request_ = false;
+                        send_error_response(StatusCode::RequestHeaderFieldsTooLarge);
+                        return;
                     }
-                    buffer_->consume(buffer_->size());
+                    fill_request();
+                    read_begin_ += parser_.head_length();
+                    header_deadline_ = false;
+                    if (!begin_request()) {
+                        return;
+                    }
+                    continue;
+                }
+
+                size_t consumed = 0;
+                std::string_view chunk;
+                ParseStatus status = parser_.parse_body(data, size, consumed, chunk);
+                read_begin_ += consumed;
+                if (status == ParseStatus::BodyChunk) {
+                    if (!on_body(chunk)) {
+                        return;
+                    }
+                }
+                else if (status == ParseStatus::Complete) {
+                    parser_.reset();
+                    if (!finish_body()) {
+                        return;
+                    }
+                    if (reader_route_) {
+                        reader_route_ = false;
+                        body_receiver_ = nullptr;
+                        // ʽ·ɵĴ彻֯һûпɵĴʱΪӳ
+                        cancel_admission();
+                        send_response(reader_response_);
+                    } else {
+                        handle_request();
+                    }
+                }
+                else if (status == ParseStatus::Error) {
+                    send_error_response(StatusCode::BadRequest);
+                    return;
+                }
+                else {
+                    return;
+                }
+            }
+        }
+
+        // ͼ request_ У֮󻺳еͷɱ
+        void fill_request() {
+            request_.clear();
+            request_.Method = stringToHttpMethod(parser_.method());
+            request_.setTarget(parser_.target());
+            request_.Version.assign(parser_.version());
+            head_request_ = request_.Method == HttpMethod::HEAD;
+            for (size_t i = 0; i < parser_.header_count(); ++i) {
+                request_.Headers.add(parser_.header_name(i), parser_.header_value(i));
+            }
+        }
+
+        // ͷɣСʽȡ·ڴʱ͵ô
+        bool begin_request() {
+            body_size_ = 0;
+            reader_route_ = false;
+            body_receiver_ = nullptr;
+
+            if (parser_.content_length() > config_->payload_max_length) {
+                send_error_response(StatusCode::PayloadTooLarge);
+                return false;
+            }
+
+            // ѹϴڽʱ룬ԭʼݣֵ֧ı뷵 415
+            body_decoder_.reset();
+            body_encoded_ = false;
+            if (auto content_encoding = request_.Headers.get(HeaderId::ContentEncoding)) {
+                auto type = parse_encoding(*content_encoding);
+                if (!type || (*type != EncodingType::Identity && !(body_decoder_ = make_decompressor(*type)))) {
+                    send_error_response(StatusCode::UnsupportedMediaType);
+                    return false;
+                }
+            }
+
+            if (routes_) {
+                routes_->refresh(route_table_, route_version_);
+            }
+            route_ = route_table_ ? route_table_->find(request_.Method, request_.Path, request_.PathParams) : nullptr;
+            if (!admit_request()) {
+                send_overload_response();
+                return false;
+            }
+            if (route_ && route_->content_reader_handler) {
+                ++request_count_;
+                reader_route_ = true;
+                reader_response_.clear();
+                ContentReader reader([this](ContentReceiver receiver) {
+                    body_receiver_ = std::move(receiver);
+                    return true;
+                });
+                route_->content_reader_handler(request_, reader_response_, reader);
+            }
+            return true;
+        }
+
+        // յһ壬 Content-Encoding ʱȽ
+        bool on_body(std::string_view chunk) {
+            if (!body_decoder_) {
+                return deliver_body(chunk);
+            }
+            bool delivered = true;
+            bool decoded = body_decoder_->decompress(chunk.data(), chunk.size(), [this, &delivered](const char* data, size_t size) {
+                delivered = deliver_body(std::string_view(data, size));
+                return delivered;
             });
+            if (!decoded && delivered) {
+                send_error_response(StatusCode::BadRequest);  // ѹ
+            }
+            body_encoded_ = true;
+            return decoded;
         }
 
-        // ʹ
-        void send_response(const std::string& response) {
-            asio::write(socket_, asio::buffer(response));
-            socket_.close();  // ر
+        // ꣺յѹʱѹضϵ巵 400
+        bool finish_body() {
+            if (body_decoder_ && body_encoded_ && !body_decoder_->is_complete()) {
+                send_error_response(StatusCode::BadRequest);
+                return false;
+            }
+            return true;
         }
 
-        void parse_request(std::shared_ptr<asio::streambuf> buffer) {
-            try {
-                std::istream request_stream(buffer.get());
-                std::string request_line;
+        // ģ壺ʽ·ֱӽ receiver׷ӵ Body
+        // ưĳȼ㣬ֹѹը
+        bool deliver_body(std::string_view chunk) {
+            body_size_ += chunk.size();
+            if (body_size_ > config_->payload_max_length) {
+                send_error_response(StatusCode::PayloadTooLarge);
+                return false;
+            }
 
-                // Ƿ
-                if (!std::getline(request_stream, request_line) || request_line.empty()) {
-                    std::cerr << "Failed to read request line or request is empty" << std::endl;
-                    return;
+            if (reader_route_) {
+                if (body_receiver_ && !body_receiver_(chunk.data(), chunk.size())) {
+                    send_error_response(StatusCode::BadRequest);
+                    return false;
                 }
+            } else {
+                request_.Body.append(chunk.data(), chunk.size());
+            }
+            return true;
+        }
 
-                std::istringstream request_line_stream(request_line);
-                std::string method, uri;
-                request_line_stream >> method >> uri;
+        // ÿηȡǰöޣ
+        //   ֮ûʱΪ keep-alive гʱ
+        //   յĵһֽںͷ header_timeout ꣬ڼյҲ˳ӣֹ slowloris ֽڷͣ
+        //   ȡʱÿյݶ˳ read_timeout
+        // ʱϵֻÿζȡҲûп
+        void start_read_timer() {
+            if (parser_.headers_complete()) {
+                timer_wheel_->schedule(read_timer_, config_->read_timeout);
+            } else if (read_begin_ < read_end_) {
+                if (!header_deadline_ || !read_timer_.pending()) {
+                    timer_wheel_->schedule(read_timer_, config_->header_timeout);
+                    header_deadline_ = true;
+                }
+            } else if (!header_deadline_ || !read_timer_.pending()) {
+                timer_wheel_->schedule(read_timer_, config_->keep_alive_timeout);
+            }
+        }
 
-                request_.setMethod(method);
-                request_.Path = uri;
+        void stop_read_timer() {
+            read_timer_.cancel();
+            header_deadline_ = false;
+        }
 
-                std::string header;
-                while (std::getline(request_stream, header) && header != "\r") {
-                    //std::cout << request_line << std::endl;
-                    size_t colon_index = header.find(':');
-                    if (colon_index != std::string::npos) {
-                        std::string key = header.substr(0, colon_index);
-                        std::string value = header.substr(colon_index + 1);
-                        trim(key); trim(value);
-                        request_.Headers[key] = value;
-                    }
+        // ʱرնȡĶ operation_aborted ء
+        // дӦʱԶڶȡݣ޴Ӧд¼
+        void on_read_timeout() {
+            if (writing_count_ > 0 && !header_deadline_ && !parser_.headers_complete()) {
+                timer_wheel_->schedule(read_timer_, config_->keep_alive_timeout);
+                return;
+            }
+            asio::error_code ignored;
+            socket_.cancel(ignored);
+        }
+
+        // дʱԶ˳ʱ䲻ȡݣȡдر
+        void on_write_timeout() {
+            asio::error_code ignored;
+            socket_.cancel(ignored);
+        }
+
+        // async_write ÿдһζ˳дޣԶ˳ȡʱӦܺʱʱ
+        auto write_deadline() {
+            return [this](const std::error_code& ec, std::size_t) -> std::size_t {
+                if (ec) {
+                    return 0;
                 }
+                timer_wheel_->schedule(write_timer_, config_->write_timeout);
+                return 65536;  //  asio::transfer_all ͬĵд
+            };
+        }
 
-                //std::cout << "Parsed request: " << method << " " << uri << std::endl;
-            } catch (const std::exception& ex) {
-                std::cerr << "Exception in parse_request: " << ex.what() << std::endl;
+        // ﵽʱܾǰ󡣼ǴͷɵӦ̣Э̺͹߳еĴ
+        bool admit_request() {
+            if (!config_->admission || admitted_) {
+                return true;
             }
+            if (!config_->admission->try_begin_request()) {
+                return false;
+            }
+            admitted_ = true;
+            dispatched_at_ = std::chrono::steady_clock::now();  // ǰͽ 413ԴΪ
+            return true;
+        }
+
+        // ӦѾͷŲѴʱӦޡ
+        // ʱꡢʱϴᱻ˱
+        void finish_admission() {
+            if (admitted_) {
+                admitted_ = false;
+                config_->admission->end_request(std::chrono::steady_clock::now() - dispatched_at_);
+            }
+        }
+
+        // ͷŲṩʱ֮ǰرգʽ·ɵѶ
+        void cancel_admission() {
+            if (admitted_) {
+                admitted_ = false;
+                config_->admission->cancel_request();
+            }
+        }
+
+        // ޣش Retry-After  503 رӣδȡ岻ٴ
+        void send_overload_response() {
+            Response response(&pool_resource_);
+            response.setStatus(StatusCode::ServiceUnavailable);
+            response.setHeader("Retry-After", std::to_string(config_->admission->retry_after().count()));
+            error_handler_(response);
+            send_response(response, false);
+        }
+
+        // жϵǰǷ񱣳
+        bool should_keep_alive() const {
+            if (request_count_ >= config_->keep_alive_max_count) {
+                return false;
+            }
+            auto connection = request_.Headers.get(HeaderId::Connection);
+            if (connection) {
+                if (iequals(*connection, "close")) return false;
+                if (iequals(*connection, "keep-alive")) return true;
+            }
+            // HTTP/1.1 ĬϳӣHTTP/1.0 Ĭ϶
+            return request_.Version != "HTTP/1.0";
+        }
+
+        // ʹ
+        void send_response(const std::string& response) {
+            asio::write(socket_, asio::buffer(response));
+            socket_.close();  // ر
         }
 
         void handle_request() {
-            Response response;
-            std::string str = methodToString(request_.Method) + ':' + request_.Path;
-            if (handlers_.count(str) > 0) {
-                handlers_[str](request_, response);
+            ++request_count_;
+            dispatched_at_ = std::chrono::steady_clock::now();
+#if defined(ASIO_HAS_CO_AWAIT)
+            if (route_ && route_->coroutine_handler) {
+                spawn_coroutine_handler();
+                return;
+            }
+#endif
+            if (route_ && route_->handler && route_->policy == ExecutionPolicy::Offload && config_->worker_pool) {
+                offload_handler();
+                return;
+            }
+            Response response(&pool_resource_);
+            if (route_ && route_->handler) {
+                route_->handler(request_, response);
+            } else if (handle_file_request(response)) {
+                return;
             } else {
                 response.setStatus(StatusCode::NotFound);
                 response.setContent("404 Not Found", "text/html");
             }
 
             send_response(response);
+        }
 
-            //std::cout << "Handled request: " << str << std::endl;
+#if defined(ASIO_HAS_CO_AWAIT)
+        //  session ִЭ̴request_ Э̽ǰֲ䣬
+        // ߻ĺڶУӦдкټ֤Ӧ˳
+        void spawn_coroutine_handler() {
+            awaiting_ = true;
+            auto self(shared_from_this());
+            asio::co_spawn(socket_.get_executor(), route_->coroutine_handler(request_),
+                [this, self](std::exception_ptr e, Response response) {
+                    complete_async_handler(e, response);
+                });
         }
+#endif
+
+        // ڹִ̳߳дЭ̴һֱͣӦ
+        // ֻ߳ request_Ӧ pool_resource_ 䣬Դ̰߳ȫ
+        void offload_handler() {
+            const Route* route = route_;
+            size_t pending = route->pending->fetch_add(1, std::memory_order_relaxed);
+            if (route->max_pending > 0 && pending >= route->max_pending) {
+                route->pending->fetch_sub(1, std::memory_order_relaxed);
+                Response response(&pool_resource_);
+                response.setStatus(StatusCode::ServiceUnavailable);
+                error_handler_(response);
+                send_response(response);
+                return;
+            }
 
-        void send_response(const Response& response) {
+            awaiting_ = true;
             auto self(shared_from_this());
+            try {
+                config_->worker_pool->post([this, self, route]() {
+                    auto response = std::make_shared<Response>();
+                    std::exception_ptr e;
+                    try {
+                        route->handler(request_, *response);
+                    } catch (...) {
+                        e = std::current_exception();
+                    }
+                    route->pending->fetch_sub(1, std::memory_order_relaxed);
+                    asio::post(socket_.get_executor(), [this, self, response, e]() {
+                        complete_async_handler(e, *response);
+                    });
+                });
+            } catch (...) {
+                // ֹ̳߳ͣɹʱһͶݵӵִ process_buffered_requests 
+                route->pending->fetch_sub(1, std::memory_order_relaxed);
+                asio::post(socket_.get_executor(), [this, self, e = std::current_exception()]() {
+                    Response response;
+                    complete_async_handler(e, response);
+                });
+            }
+        }
+
+        // Э̻߳еĴɣӦеĺ
+        void complete_async_handler(std::exception_ptr e, Response& response) {
+            awaiting_ = false;
+            if (closing_) {
+                finish_if_idle();  // ȴڼдʧܣѽر
+                return;
+            }
+            if (e) {
+                try {
+                    std::rethrow_exception(e);
+                } catch (const std::exception& ex) {
+                    std::cerr << "Exception in handler: " << ex.what() << std::endl;
+                } catch (...) {
+                }
+                send_error_response(StatusCode::InternalServerError);
+            } else {
+                send_response(response);
+            }
+            process_buffered_requests();
+            flush_output();
+            read_request();
+            finish_if_idle();
+        }
+
+        // صҾ̬ļͣIf-None-Match / If-Modified-Since͵ Range
+        // ûƥĹصļʱ false
+        bool handle_file_request(Response& response) {
+            if (config_->mount_points.empty() || (request_.Method != HttpMethod::GET && request_.Method != HttpMethod::HEAD)) {
+                return false;
+            }
+            auto path = resolve_file_path(config_->mount_points, request_.Path);
+            if (!path) {
+                return false;
+            }
+            // Range 󽻸 sendfile ·
+            if (config_->asset_cache && !request_.Headers.has(HeaderId::Range)) {
+                if (auto asset = config_->asset_cache->get(*path)) {
+                    send_asset(response, std::move(asset));
+                    return true;
+                }
+            }
+            auto file = config_->file_cache->open(*path);
+            if (!file) {
+                return false;
+            }
+
+            response.setHeader("Content-Type", file->content_type());
+            response.setHeader("ETag", file->etag());
+            response.setHeader("Last-Modified", file->last_modified());
+            response.setHeader("Accept-Ranges", "bytes");
+
+            if (is_not_modified(file->etag(), file->stat().mtime)) {
+                response.setStatus(StatusCode::NotModified);
+                send_response(response);
+                return true;
+            }
+
+            FileBody body{ file, 0, file->size() };
+            auto range = request_.Headers.get(HeaderId::Range);
+            if (range && if_range_matches(file->etag(), file->stat().mtime)) {
+                ByteRange byte_range;
+                switch (parse_byte_range(*range, file->size(), byte_range)) {
+                case RangeResult::Satisfiable: {
+                    body.offset = byte_range.offset;
+                    body.length = byte_range.length;
+                    response.setStatus(StatusCode::PartialContent);
+                    std::string content_range = "bytes " + std::to_string(byte_range.offset) + "-"
+                        + std::to_string(byte_range.offset + byte_range.length - 1) + "/" + std::to_string(file->size());
+                    response.setHeader("Content-Range", content_range);
+                    break;
+                }
+                case RangeResult::Unsatisfiable:
+                    response.removeHeader("Content-Type");
+                    response.setStatus(StatusCode::RangeNotSatisfiable);
+                    response.setHeader("Content-Range", "bytes */" + std::to_string(file->size()));
+                    send_response(response);
+                    return true;
+                case RangeResult::None:
+                    break;
+                }
+            }
+
+            if (request_.Method == HttpMethod::HEAD) {
+                body.file = nullptr;
+            }
+            send_response(response, should_keep_alive(), &body);
+            return true;
+        }
 
-            auto response_data = std::make_shared<std::string>();
-            std::ostringstream response_stream;
-            response_stream << "HTTP/1.1 " << static_cast<int>(response.StatCde) << " " << response.StatusMsg << "\r\n";
+        //  AssetCache Ӧ Accept-Encoding ѡԤѹ汾ͷӦֱûеݣ
+        void send_asset(Response& response, std::shared_ptr<const Asset> asset) {
+            auto accept_encoding = request_.Headers.get(HeaderId::AcceptEncoding);
+            const Asset::Variant& variant = asset->select(accept_encoding ? *accept_encoding : std::string_view());
+            if (is_not_modified(variant.etag, asset->stat.mtime)) {
+                response.setStatus(StatusCode::NotModified);
+                response.setHeader("ETag", variant.etag);
+                response.setHeader("Last-Modified", asset->last_modified);
+                send_response(response);
+                return;
+            }
+
+            bool keep_alive = should_keep_alive();
+            PendingResponse pending{ statusLine(StatusCode::OK), std::pmr::string(arena_.resource()), {}, keep_alive };
+            pending.shared_head = variant.head;
+            if (request_.Method != HttpMethod::HEAD) {
+                pending.shared_body = variant.body;
+            }
+            pending.holder = std::move(asset);
+            pending.head.reserve(96);
+            pending.head.append("Date: ").append(cached_http_date()).append("\r\n");
+            append_connection_headers(pending.head, keep_alive);
+            enqueue(std::move(pending));
+        }
+
+        // If-None-Match  If-Modified-Since
+        bool is_not_modified(std::string_view etag, std::time_t mtime) const {
+            if (auto none_match = request_.Headers.get(HeaderId::IfNoneMatch)) {
+                return etag_matches(*none_match, etag);
+            }
+            if (auto modified_since = request_.Headers.get(HeaderId::IfModifiedSince)) {
+                std::time_t since;
+                return parse_http_date(*modified_since, since) && mtime <= since;
+            }
+            return false;
+        }
+
+        // If-Range 뵱ǰļһʱ Range
+        bool if_range_matches(std::string_view etag, std::time_t mtime) const {
+            auto if_range = request_.Headers.get(HeaderId::IfRange);
+            if (!if_range) {
+                return true;
+            }
+            if (!if_range->empty() && if_range->front() == '"') {
+                return *if_range == etag;
+            }
+            std::time_t date;
+            return parse_http_date(*if_range, date) && mtime == date;
+        }
+
+        // лӦͷУ״̬ʹþַ̬ͷд arena_Ӧ response У
+        // ú response.Body Ϊաfile ΪʱļΪӦ
+        void send_response(Response& response, bool keep_alive, const FileBody* file = nullptr) {
+            std::unique_ptr<StreamBody> stream;
+            if (response.hasContentProvider()) {
+                stream = make_stream_body(response, keep_alive);
+            } else if (!file) {
+                compress_body(response);
+            }
+            PendingResponse pending{ {}, std::pmr::string(arena_.resource()), {}, keep_alive };
+            std::pmr::string& head = pending.head;
+
+            size_t size = 160;
             for (const auto& [key, value] : response.Headers) {
-                response_stream << key << ": " << value << "\r\n";
+                size += key.size() + value.size() + 4;
+            }
+            head.reserve(size);
+
+            // ԭ׼һʱֱþ̬״̬
+            std::string_view line = statusLine(response.StatCde);
+            if (line.size() > 15 && line.substr(13, line.size() - 15) == response.StatusMsg) {
+                pending.status_line = line;
+            } else {
+                head.append("HTTP/1.1 ");
+                append_number(head, static_cast<int>(response.StatCde));
+                head.append(" ").append(response.StatusMsg).append("\r\n");
             }
-            response_stream << "Content-Length: " << response.Body.size() << "\r\n";
-            response_stream << "Connection: close\r\n\r\n";
-            response_stream << response.Body;
 
-            *response_data = response_stream.str();  // 浽 shared_ptr 
+            for (auto it = response.Headers.begin(); it != response.Headers.end(); ++it) {
+                if (it.id() == HeaderId::ContentLength || it.id() == HeaderId::Connection) continue;
+                auto [key, value] = *it;
+                head.append(key).append(": ").append(value).append("\r\n");
+            }
+            if (!response.Headers.has(HeaderId::Date)) {
+                head.append("Date: ").append(cached_http_date()).append("\r\n");
+            }
+            if (stream && stream->chunked) {
+                head.append("Transfer-Encoding: chunked\r\n");
+            } else if (stream && stream->chunked_provider) {
+                // HTTP/1.0 ֧ chunkedԹرӱʾӦ
+            } else if (response.StatCde != StatusCode::NotModified && response.StatCde != StatusCode::NoContent) {
+                head.append("Content-Length: ");
+                append_number(head, file ? file->length : stream ? stream->length : response.Body.size());
+                head.append("\r\n");
+            }
+            append_connection_headers(head, keep_alive);
 
-            asio::async_write(socket_, asio::buffer(*response_data),
-                [this, self, response_data](std::error_code ec, std::size_t length) {
+            // HEAD Ӧ Content-LengthӦ壬ϵһӦλ
+            if (!head_request_) {
+                pending.body = std::move(response.Body);
+            }
+            response.Body.clear();
+            if (file && file->file && file->length > 0) {
+                pending.file = *file;
+            }
+            if (stream && !head_request_) {
+                pending.stream = std::move(stream);
+            }
+            enqueue(std::move(pending));
+        }
+
+        // ӦУӦѾͬʱͷŵǰռõĲ
+        void enqueue(PendingResponse&& pending) {
+            finish_admission();
+            output_queue_.push_back(std::move(pending));
+        }
+
+        // ѹ׶εЭ̣ͻ˽ܡʺѹӦ岻С compress_min_size ʱõı
+        EncodingType negotiate_compression(const Response& response, uint64_t size) const {
+            if (!config_->compress || size < config_->compress_min_size
+                || response.StatCde == StatusCode::PartialContent || response.Headers.has(HeaderId::ContentEncoding)) {
+                return EncodingType::Identity;
+            }
+            auto content_type = response.Headers.get(HeaderId::ContentType);
+            auto accept_encoding = request_.Headers.get(HeaderId::AcceptEncoding);
+            if (!content_type || !accept_encoding || !can_compress(*content_type)) {
+                return EncodingType::Identity;
+            }
+            return select_encoding(*accept_encoding);
+        }
+
+        // Ӧѹ׶ΣѹӦ岢 Content-EncodingѹȡԵǰ reactor ̵߳Ļ
+        void compress_body(Response& response) {
+            EncodingType type = negotiate_compression(response, response.Body.size());
+            auto compressor = make_compressor(type, config_->compression_level);
+            if (!compressor) {
+                return;
+            }
+
+            std::string compressed;
+            compressed.reserve(response.Body.size() / 2);
+            Compressor::Sink sink = [&compressed](const char* data, size_t size) {
+                compressed.append(data, size);
+                return true;
+            };
+            const char* data = response.Body.data();
+            size_t remaining = response.Body.size();
+            do {
+                size_t size = (std::min)(remaining, CPPHTTPLIB_COMPRESS_CHUNK_SIZE);
+                if (!compressor->compress(data, size, size == remaining, sink)) {
+                    return;  // ѹʧʱԭ
+                }
+                data += size;
+                remaining -= size;
+            } while (remaining > 0);
+
+            response.Body.swap(compressed);
+            response.setHeader("Content-Encoding", encoding_name(type));
+            response.addHeader("Vary", "Accept-Encoding");
+        }
+
+        //  response ȡ providerHTTP/1.1 ³δ֪Ҫѹ chunked 뷢ͣ
+        // HTTP/1.0 ѹδ֪ʱϺر
+        std::unique_ptr<StreamBody> make_stream_body(Response& response, bool& keep_alive) {
+            auto stream = std::make_unique<StreamBody>();
+            stream->provider = std::move(response.contentProvider_);
+            stream->chunked_provider = std::move(response.chunkedContentProvider_);
+            stream->releaser = std::move(response.contentProviderResourceReleaser_);
+            stream->length = response.contentLength_;
+            response.contentProvider_ = nullptr;
+            response.chunkedContentProvider_ = nullptr;
+            response.contentProviderResourceReleaser_ = nullptr;
+
+            if (request_.Version == "HTTP/1.0") {
+                if (stream->chunked_provider) {
+                    keep_alive = false;
+                }
+                return stream;
+            }
+            stream->chunked = static_cast<bool>(stream->chunked_provider);
+            uint64_t size = stream->chunked ? (std::numeric_limits<uint64_t>::max)() : stream->length;
+            EncodingType type = negotiate_compression(response, size);
+            if ((stream->compressor = make_compressor(type, config_->compression_level))) {
+                stream->chunked = true;
+                response.setHeader("Content-Encoding", encoding_name(type));
+                response.addHeader("Vary", "Accept-Encoding");
+            }
+            return stream;
+        }
+
+        // д Connection / Keep-Alive ͷͽβĿ
+        void append_connection_headers(std::pmr::string& head, bool keep_alive) {
+            if (keep_alive) {
+                head.append("Connection: keep-alive\r\nKeep-Alive: timeout=");
+                append_number(head, config_->keep_alive_timeout.count());
+                head.append(", max=");
+                append_number(head, config_->keep_alive_max_count - request_count_);
+                head.append("\r\n\r\n");
+            } else {
+                head.append("Connection: close\r\n\r\n");
+                closing_ = true;  // ֮еٴ
+            }
+        }
+
+        template <typename Number>
+        static void append_number(std::pmr::string& out, Number value) {
+            char buf[24];
+            auto result = std::to_chars(buf, buf + sizeof(buf), value);
+            out.append(buf, result.ptr);
+        }
+
+        // ѾӦϲΪһ gather writewritevдļӦʱͷֹ֮
+        // ͷдٷļ
+        void flush_output() {
+            if (writing_count_ > 0 || output_queue_.empty()) {
+                return;
+            }
+
+            write_buffers_.clear();
+            for (const auto& pending : output_queue_) {
+                if (!pending.status_line.empty()) {
+                    write_buffers_.push_back(asio::buffer(pending.status_line.data(), pending.status_line.size()));
+                }
+                if (!pending.shared_head.empty()) {
+                    write_buffers_.push_back(asio::buffer(pending.shared_head.data(), pending.shared_head.size()));
+                }
+                write_buffers_.push_back(asio::buffer(pending.head.data(), pending.head.size()));
+                if (!pending.body.empty()) {
+                    write_buffers_.push_back(asio::buffer(pending.body));
+                }
+                if (!pending.shared_body.empty()) {
+                    write_buffers_.push_back(asio::buffer(pending.shared_body.data(), pending.shared_body.size()));
+                }
+                ++writing_count_;
+                if (!pending.keep_alive || pending.file.file || pending.stream) {
+                    break;
+                }
+            }
+
+            auto self(shared_from_this());
+            //  span 룬 async_write ڲ buffer 
+            asio::async_write(socket_, std::span<const asio::const_buffer>(write_buffers_), write_deadline(),
+                bind_memory(write_memory_, [this, self](std::error_code ec, std::size_t) {
+                    const PendingResponse& last = output_queue_[writing_count_ - 1];
+                    if (!ec && last.file.file) {
+                        send_file_body();
+                    } else if (!ec && last.stream) {
+                        send_stream_body();
+                    } else {
+                        complete_write(ec);
+                    }
+                }));
+        }
+
+        // ͶһдӦļݡ
+        // Linux  sendfile(2) ļֱд socketsocket ʱȴд
+        // ƽ̨ file_buffer_ д
+        void send_file_body() {
+            FileBody& body = output_queue_[writing_count_ - 1].file;
+            auto self(shared_from_this());
+#if defined(HTTP_ASIO_HAS_SENDFILE)
+            asio::error_code ec;
+            socket_.native_non_blocking(true, ec);
+            while (!ec && body.length > 0) {
+                off_t offset = static_cast<off_t>(body.offset);
+                size_t count = static_cast<size_t>((std::min<uint64_t>)(body.length, 0x7ffff000u));
+                ssize_t n = ::sendfile(socket_.native_handle(), body.file->native_handle(), &offset, count);
+                if (n > 0) {
+                    body.offset += static_cast<uint64_t>(n);
+                    body.length -= static_cast<uint64_t>(n);
+                } else if (n == 0) {
+                    ec = asio::error::eof;  // ļڷ͹бض
+                } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    timer_wheel_->schedule(write_timer_, config_->write_timeout);
+                    socket_.async_wait(asio::ip::tcp::socket::wait_write, bind_memory(write_memory_, [this, self](std::error_code ec) {
+                        if (ec) {
+                            complete_write(ec);
+                        } else {
+                            send_file_body();
+                        }
+                    }));
+                    return;
+                } else if (errno != EINTR) {
+                    ec = asio::error_code(errno, asio::error::get_system_category());
+                }
+            }
+            complete_write(ec);
+#else
+            if (body.length == 0) {
+                complete_write({});
+                return;
+            }
+            file_buffer_.resize(CPPHTTPLIB_FILE_CHUNK_SIZE);
+            size_t count = static_cast<size_t>((std::min<uint64_t>)(body.length, file_buffer_.size()));
+            long long n = body.file->read_at(file_buffer_.data(), count, body.offset);
+            if (n <= 0) {
+                complete_write(n == 0 ? asio::error_code(asio::error::eof) : asio::error_code(errno, asio::error::get_system_category()));
+                return;
+            }
+            body.offset += static_cast<uint64_t>(n);
+            body.length -= static_cast<uint64_t>(n);
+            asio::async_write(socket_, asio::buffer(file_buffer_.data(), static_cast<size_t>(n)), write_deadline(),
+                bind_memory(write_memory_, [this, self](std::error_code ec, std::size_t) {
                     if (ec) {
-                        send_error_response(StatusCode::InternalServerError);
+                        complete_write(ec);
+                    } else {
+                        send_file_body();
                     }
+                }));
+#endif
+        }
 
-                    returnSession();
-                });
+        // ηʽӦ壺һΡдһΣдٴε providerѹ
+        void send_stream_body() {
+            StreamBody& stream = *output_queue_[writing_count_ - 1].stream;
+            if (!produce_stream_data(stream)) {
+                complete_write(asio::error_code(asio::error::eof));  // provider ǰѷ͵ Content-Length ޷㣬ֻܶϿ
+                return;
+            }
+            if (stream_buffer_.empty()) {
+                complete_write({});
+                return;
+            }
+            auto self(shared_from_this());
+            asio::async_write(socket_, asio::buffer(stream_buffer_), write_deadline(),
+                bind_memory(write_memory_, [this, self](std::error_code ec, std::size_t) {
+                    if (ec) {
+                        complete_write(ec);
+                    } else {
+                        send_stream_body();
+                    }
+                }));
+        }
+
+        //  provider һݣѹ chunked ֡ stream_buffer_
+        // ѹʱûʱ providerֱݿдprovider ʱ false
+        bool produce_stream_data(StreamBody& stream) {
+            stream_buffer_.clear();
+            std::function<void(const std::string&)> sink = [this](const std::string& data) {
+                stream_raw_.append(data);
+            };
+            Compressor::Sink compress_sink = [this](const char* data, size_t size) {
+                stream_compressed_.append(data, size);
+                return true;
+            };
+
+            while (stream_buffer_.empty() && !stream.finished) {
+                stream_raw_.clear();
+                bool end = false;
+                if (stream.chunked_provider) {
+                    stream.chunked_provider(CPPHTTPLIB_CONTENT_PROVIDER_CHUNK_SIZE, sink);
+                    end = stream_raw_.empty();
+                } else if (stream.offset >= stream.length) {
+                    end = true;
+                } else {
+                    uint64_t remaining = stream.length - stream.offset;
+                    stream.provider(static_cast<size_t>(stream.offset),
+                        static_cast<size_t>((std::min<uint64_t>)(remaining, CPPHTTPLIB_CONTENT_PROVIDER_CHUNK_SIZE)), sink);
+                    if (stream_raw_.empty() || stream_raw_.size() > remaining) {
+                        return false;
+                    }
+                    stream.offset += stream_raw_.size();
+                }
+
+                std::string* data = &stream_raw_;
+                if (stream.compressor) {
+                    stream_compressed_.clear();
+                    if (!stream.compressor->compress(stream_raw_.data(), stream_raw_.size(), end, compress_sink)) {
+                        return false;
+                    }
+                    data = &stream_compressed_;
+                }
+                if (!stream.chunked) {
+                    stream_buffer_.swap(*data);
+                } else if (!data->empty()) {
+                    char size_line[20];
+                    auto result = std::to_chars(size_line, size_line + sizeof(size_line), data->size(), 16);
+                    stream_buffer_.append(size_line, result.ptr).append("\r\n").append(*data).append("\r\n");
+                }
+                if (end) {
+                    stream.finished = true;
+                    if (stream.chunked) {
+                        stream_buffer_.append("0\r\n\r\n");
+                    }
+                }
+            }
+            return true;
+        }
+
+        // дӦȫд꣨ӣдӦر
+        void complete_write(std::error_code ec) {
+            write_timer_.cancel();
+            bool keep_alive = output_queue_[writing_count_ - 1].keep_alive;
+            for (size_t i = 0; i < writing_count_; ++i) {
+                output_queue_.pop_front();
+            }
+            writing_count_ = 0;
+            if (output_queue_.empty()) {
+                arena_.rewind();  // лӦȫдarena вд
+            }
+
+            if (ec || !keep_alive) {
+                closing_ = true;
+                output_queue_.clear();
+                finish_if_idle();
+                return;
+            }
+
+            flush_output();
+            if (read_paused_) {
+                read_paused_ = false;
+                read_request();
+            }
+            finish_if_idle();
+        }
+
+        // ӽرҶдѽʱر socket 黹 session
+        void finish_if_idle() {
+            if (!closing_ || awaiting_ || writing_count_ > 0 || !output_queue_.empty()) {
+                return;
+            }
+            asio::error_code ignored;
+            if (reading_) {
+                socket_.cancel(ignored);  // صغٴν
+                return;
+            }
+            if (!returned_) {
+                returned_ = true;
+                socket_.shutdown(asio::ip::tcp::socket::shutdown_both, ignored);
+                returnSession();
+            }
+        }
+
+        void send_response(Response& response) {
+            send_response(response, should_keep_alive());
         }
 
         void send_error_response(StatusCode status_code) {
-            Response response;
-            response.StatCde = status_code;
+            Response response(&pool_resource_);
+            response.setStatus(status_code);
             error_handler_(response);
-            send_response(response);
+            send_response(response, false);
         }
     };
 
+    // SessionPool ͳϢ
+    struct SessionPoolStats {
+        size_t hits = 0;        // ÿ session Ĵ
+        size_t misses = 0;      // ½ session Ĵ
+        size_t dropped = 0;     // бֱͷŵ session 
+        size_t idle = 0;        // ǰе session 
+    };
+
+    // ÿ reactor һ SessionPoolֻڸ reactor ߳ȡú͹黹˿бҪ
+    // бĳȲ ServerConfig::session_pool_max_sizeȶʱӲٷڴ档
     class SessionPool : public std::enable_shared_from_this<SessionPool> {
     public:
-        SessionPool(std::shared_ptr<IOContextWrapper> io_context, std::function<void(Response&)> error_handler)
-            : io_context_(io_context), error_handler_(error_handler) {}
+        SessionPool(std::shared_ptr<IOContextWrapper> io_context, std::function<void(Response&)> error_handler,
+            std::shared_ptr<const ServerConfig> config)
+            : io_context_(io_context), error_handler_(error_handler), config_(config),
+            timer_wheel_(std::make_shared<TimerWheel>(*io_context->getContext())) {}
 
 		~SessionPool() {
-			std::lock_guard<std::mutex> lock(mutex_);
-			while (!idle_sessions_.empty()) {
-				idle_sessions_.pop();
-			}
+			idle_sessions_.clear();
 			std::cout << "SessionPool destroyed" << std::endl;
 		}
 
-        std::shared_ptr<Session> getSession(asio::ip::tcp::socket socket) {
-            std::unique_lock<std::mutex> lock(mutex_);
+        // ȡһ sessionûʱ½һ socket δ
+        std::shared_ptr<Session> acquire() {
             if (!idle_sessions_.empty()) {
-                std::shared_ptr<Session> session = idle_sessions_.front();
-				session->assignSocket(std::move(socket));
-                idle_sessions_.pop();
+                std::shared_ptr<Session> session = std::move(idle_sessions_.back());
+                idle_sessions_.pop_back();
+                idle_count_.store(idle_sessions_.size(), std::memory_order_relaxed);
+                hits_.fetch_add(1, std::memory_order_relaxed);
                 return session;
             }
-            return std::make_shared<Session>(std::move(socket), io_context_, error_handler_, shared_from_this());
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            return std::make_shared<Session>(asio::ip::tcp::socket(*io_context_->getContext()),
+                io_context_, error_handler_, shared_from_this(), config_, timer_wheel_);
+        }
+
+        // ѽܵ socket ȡһ session
+        std::shared_ptr<Session> getSession(asio::ip::tcp::socket socket) {
+            std::shared_ptr<Session> session = acquire();
+            session->assignSocket(std::move(socket));
+            return session;
         }
 
-        void returnSession(std::shared_ptr<Session> session) {
-            std::lock_guard<std::mutex> lock(mutex_);
-            idle_sessions_.push(session);
+        // 黹 session״̬Żؿббʱֱͷ
+        void release(std::shared_ptr<Session> session) {
+            if (idle_sessions_.size() >= config_->session_pool_max_size) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            session->reset();
+            idle_sessions_.push_back(std::move(session));
+            idle_count_.store(idle_sessions_.size(), std::memory_order_relaxed);
         }
 
+        //  Run() ֮ǰ
 		void setError_handler(std::function<void(Response&)> handler) {
 			error_handler_ = handler;
+            for (auto& session : idle_sessions_) {
+                session->setErrorHandler(handler);
+            }
 		}
 
+        // ̶߳ȡ
+        SessionPoolStats stats() const {
+            SessionPoolStats stats;
+            stats.hits = hits_.load(std::memory_order_relaxed);
+            stats.misses = misses_.load(std::memory_order_relaxed);
+            stats.dropped = dropped_.load(std::memory_order_relaxed);
+            stats.idle = idle_count_.load(std::memory_order_relaxed);
+            return stats;
+        }
+
     private:
         std::shared_ptr<IOContextWrapper> io_context_;
         std::function<void(Response&)> error_handler_;
-        std::queue<std::shared_ptr<Session>> idle_sessions_;
-        std::mutex mutex_;
+        std::shared_ptr<const ServerConfig> config_;
+        std::shared_ptr<TimerWheel> timer_wheel_;     //  reactor ӹõĳʱʱ
+        std::vector<std::shared_ptr<Session>> idle_sessions_;
+        std::atomic<size_t> hits_{ 0 };
+        std::atomic<size_t> misses_{ 0 };
+        std::atomic<size_t> dropped_{ 0 };
+        std::atomic<size_t> idle_count_{ 0 };
+    };
+
+    // ʱܵӣдԤɵ 503رշͷȡͻʣݣ
+    // ֱԶ˹رջȴ CPPHTTPLIB_REJECT_LINGER_MSECOND
+    // ջлδʱֱ close ᷢ RSTͻ˿ղ 503
+    // ǰͨ AdmissionControl::try_acquire_rejector ȡʱ黹
+    class OverloadRejector : public std::enable_shared_from_this<OverloadRejector> {
+    public:
+        OverloadRejector(asio::ip::tcp::socket socket, std::shared_ptr<AdmissionControl> admission)
+            : socket_(std::move(socket)), timer_(socket_.get_executor()), admission_(std::move(admission)) {}
+
+        ~OverloadRejector() {
+            admission_->release_rejector();
+        }
+
+        void start() {
+            auto self(shared_from_this());
+            timer_.expires_after(std::chrono::milliseconds(CPPHTTPLIB_REJECT_LINGER_MSECOND));
+            timer_.async_wait([this, self](std::error_code ec) {
+                if (!ec) {
+                    close();
+                }
+            });
+            asio::async_write(socket_, asio::buffer(admission_->overload_response()),
+                [this, self](std::error_code ec, std::size_t) {
+                    if (ec) {
+                        return close();
+                    }
+                    asio::error_code ignored;
+                    socket_.shutdown(asio::ip::tcp::socket::shutdown_send, ignored);
+                    drain();
+                });
+        }
+
+    private:
+        asio::ip::tcp::socket socket_;
+        asio::steady_timer timer_;
+        std::shared_ptr<AdmissionControl> admission_;   //  503 Ӧ
+        char buffer_[512];
+
+        void drain() {
+            auto self(shared_from_this());
+            socket_.async_read_some(asio::buffer(buffer_), [this, self](std::error_code ec, std::size_t) {
+                if (ec) {
+                    return close();
+                }
+                drain();
+            });
+        }
+
+        void close() {
+            asio::error_code ignored;
+            timer_.cancel();
+            socket_.close(ignored);
+        }
+    };
+
+    //  reactor ģʽӵķ䷽ʽ
+    enum class AcceptMode {
+        ReusePort,          // ÿ reactor ԼSO_REUSEPORTں˷
+        RoundRobin,         //  acceptor Ӻ reactor
+        LeastConnections    //  acceptor Ӻ󽻸ǰٵ reactor
+    };
+
+    // һ reactor Ӧһ io_context һ̣߳Ӵӽرնֻͬһ reactor ϴ
+    // reactor ֮䲻κοɱ״̬
+    struct Reactor {
+        std::shared_ptr<IOContextWrapper> io_context;
+        std::shared_ptr<SessionPool> session_pool;
+        std::unique_ptr<asio::ip::tcp::acceptor> acceptor;
+        std::atomic<bool> accept_paused{ false };       // ͣ acceptȴ AdmissionControl ָ֪ͨ
     };
 
     class Server {
     public:
+        //  reactorӶ io_context ϴRun() ڵ߳
         Server(short port, std::shared_ptr<IOContextWrapper> io_context = std::make_shared<IOContextWrapper>())
-            : acceptor_(*io_context->getContext(), asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port)),
-            io_context_(io_context), session_pool_(std::make_shared<SessionPool>(io_context_, Server::errorHandlerFunc)) {
-            start_accept();
+            : config_(std::make_shared<ServerConfig>()), port_(port), accept_mode_(AcceptMode::ReusePort) {
+            Reactor& reactor = add_reactor(io_context);
+            reactor.acceptor = std::make_unique<asio::ip::tcp::acceptor>(*io_context->getContext(),
+                asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port));
+            start_accept(reactor);
+        }
+
+        //  reactor IOContextPool ṩ reactor_count  io_context ̣߳reactor_count Ϊ 0 ʱȡ CPU 
+        // ֧ SO_REUSEPORT ƽ̨ ReusePort ˻Ϊ RoundRobin
+        Server(short port, size_t reactor_count, AcceptMode mode = AcceptMode::ReusePort)
+            : config_(std::make_shared<ServerConfig>()), port_(port), accept_mode_(mode) {
+            if (reactor_count == 0) {
+                reactor_count = (std::max)(1u, std::thread::hardware_concurrency());
+            }
+#ifndef SO_REUSEPORT
+            if (accept_mode_ == AcceptMode::ReusePort) {
+                accept_mode_ = AcceptMode::RoundRobin;
+            }
+#endif
+            pool_ = std::make_unique<IOContextPool>(reactor_count, accept_mode_ == AcceptMode::LeastConnections
+                ? ContextSelectMode::LeastConnections : ContextSelectMode::RoundRobin, false);
+            pool_->setThreadName("http-reactor");
+            for (size_t i = 0; i < reactor_count; ++i) {
+                add_reactor(pool_->getWrapper(i));
+            }
+
+            if (accept_mode_ == AcceptMode::ReusePort) {
+                for (auto& reactor : reactors_) {
+                    reactor->acceptor = make_acceptor(*reactor, true);
+                    start_accept(*reactor);
+                }
+            } else {
+                reactors_[0]->acceptor = make_acceptor(*reactors_[0], false);
+                start_accept_handoff();
+            }
         }
 
 		~Server() {
+            Stop();
+            if (pool_) {
+                pool_->join();
+            }
+            if (owns_worker_pool_ && config_->worker_pool) {
+                config_->worker_pool->stop();  // ȴ߳˳Ͷݻ reactor  io_context һ
+            }
+            if (config_->asset_cache) {
+                config_->asset_cache->unwatch();  // inotify  reactor 0  io_context 
+            }
 			std::cout << "Server destroyed" << std::endl;
 		}
-
+        // ע·ɣpattern ֧ ":name" κĩβ "*name" ͨ
         Server& Get(const std::string& pattern, Handler handler) {
-            handlers_["GET:" + pattern] = handler;
-            return *this;
+            return route(HttpMethod::GET, pattern, std::move(handler));
         }
 
         Server& Post(const std::string& pattern, Handler handler) {
-            handlers_["POST:" + pattern] = handler;
-            return *this;
+            return route(HttpMethod::POST, pattern, std::move(handler));
+        }
+
+        // ݿʽʽ建
+        Server& Post(const std::string& pattern, HandlerWithContentReader handler) {
+            return route(HttpMethod::POST, pattern, std::move(handler));
+        }
+
+        Server& Put(const std::string& pattern, Handler handler) {
+            return route(HttpMethod::PUT, pattern, std::move(handler));
+        }
+
+        Server& Put(const std::string& pattern, HandlerWithContentReader handler) {
+            return route(HttpMethod::PUT, pattern, std::move(handler));
+        }
+
+        Server& Patch(const std::string& pattern, Handler handler) {
+            return route(HttpMethod::PATCH, pattern, std::move(handler));
         }
 
+        Server& Patch(const std::string& pattern, HandlerWithContentReader handler) {
+            return route(HttpMethod::PATCH, pattern, std::move(handler));
+        }
+
+        Server& Delete(const std::string& pattern, Handler handler) {
+            return route(HttpMethod::DEL, pattern, std::move(handler));
+        }
+
+        Server& Delete(const std::string& pattern, HandlerWithContentReader handler) {
+            return route(HttpMethod::DEL, pattern, std::move(handler));
+        }
+
+        Server& Options(const std::string& pattern, Handler handler) {
+            return route(HttpMethod::OPTIONS, pattern, std::move(handler));
+        }
+
+#if defined(ASIO_HAS_CO_AWAIT)
+        // Э̴ reactor  co_spawnco_return  Response ΪӦ
+        Server& Get(const std::string& pattern, CoroutineHandler handler) {
+            return route(HttpMethod::GET, pattern, std::move(handler));
+        }
+
+        Server& Post(const std::string& pattern, CoroutineHandler handler) {
+            return route(HttpMethod::POST, pattern, std::move(handler));
+        }
+
+        Server& Put(const std::string& pattern, CoroutineHandler handler) {
+            return route(HttpMethod::PUT, pattern, std::move(handler));
+        }
+
+        Server& Patch(const std::string& pattern, CoroutineHandler handler) {
+            return route(HttpMethod::PATCH, pattern, std::move(handler));
+        }
+
+        Server& Delete(const std::string& pattern, CoroutineHandler handler) {
+            return route(HttpMethod::DEL, pattern, std::move(handler));
+        }
+
+        Server& Options(const std::string& pattern, CoroutineHandler handler) {
+            return route(HttpMethod::OPTIONS, pattern, std::move(handler));
+        }
+#endif
+
         void set_error_handler(std::function<void(Response&)> handler) {
             error_handler_ = handler;
-            session_pool_->setError_handler(handler);
+            for (auto& reactor : reactors_) {
+                reactor->session_pool->setError_handler(handler);
+            }
+        }
+
+        // ·ɵִзʽOffload ·ڹִ̳߳У io ̣߳
+        // max_pending > 0 ʱ·ŶӺִеﵽ޺ֱӷ 503·ɲռ̳߳ء
+        // עᴦ֮ǰ֮ã޸ĺ commit_routes()
+        Server& set_execution_policy(HttpMethod method, const std::string& pattern, ExecutionPolicy policy,
+            size_t max_pending = 0) {
+            Route& route = router_.emplace(method, pattern);
+            route.policy = policy;
+            route.max_pending = max_pending;
+            if (policy == ExecutionPolicy::Offload) {
+                has_offload_routes_ = true;
+            }
+            return *this;
+        }
+
+        // ʹⲿĹ̳߳أ豣֤ Server ǰֹͣ
+        void set_worker_pool(std::shared_ptr<ThreadPool> pool) {
+            config_->worker_pool = std::move(pool);
+            owns_worker_pool_ = false;
+        }
+
+        // ڲ̳߳ص߳ĬΪ CPU  Run() ֮ǰ
+        void set_worker_threads(size_t count) {
+            worker_threads_ = count;
+        }
+
+        // 0 ʾƣ Run() ֮ǰ
+        void set_max_connections(size_t count) {
+            config_->max_connections = count;
+        }
+
+        // 󲢷ͷɵӦʱ 5030 ʾƣ Run() ֮ǰ
+        void set_max_inflight_requests(size_t count) {
+            config_->max_inflight_requests = count;
+        }
+
+        // ôﵽ޺ӵĴʽPause ͣ acceptReject ֱӷ 503 ر
+        void set_overload_action(OverloadAction action) {
+            config_->overload_action = action;
+        }
+
+        //  503 Ӧе Retry-After Run() ֮ǰ
+        void set_retry_after(std::chrono::seconds seconds) {
+            config_->retry_after = seconds;
+        }
+
+        // ʹӦޣAimdLimitGradientLimit ȣ set_max_inflight_requests ͬʱʱȡСߣ
+        //  Run() ֮ǰ
+        void set_concurrency_limit(std::shared_ptr<ConcurrencyLimit> limit) {
+            config_->concurrency_limit = std::move(limit);
+        }
+
+        //  reactor ģʽ° reactor i ̰߳󶨵 CPU i %  Run() ֮ǰ
+        void set_cpu_affinity(bool enable) {
+            cpu_affinity_ = enable;
+        }
+
+        // õദ
+        void set_keep_alive_max_count(size_t count) {
+            config_->keep_alive_max_count = count;
+        }
+
+        // 󳤶
+        void set_payload_max_length(size_t length) {
+            config_->payload_max_length = length;
+        }
+
+        // ÿ reactor ໺Ŀ session 
+        void set_session_pool_max_size(size_t size) {
+            config_->session_pool_max_size = size;
+        }
+
+        //  mount_point ǰ׺µӳ䵽Ŀ¼ dir еľ̬ļûƥ·ʱɹص㴦 GET/HEAD 
+        // dir Ŀ¼ʱ false
+        bool set_mount_point(const std::string& mount_point, const std::string& dir) {
+            FileStat st;
+            if (mount_point.empty() || mount_point[0] != '/' || !stat_file(dir, st) || !st.directory) {
+                return false;
+            }
+            std::string base_dir = dir;
+            while (base_dir.size() > 1 && (base_dir.back() == '/' || base_dir.back() == '\\')) {
+                base_dir.pop_back();
+            }
+            remove_mount_point(mount_point);
+            config_->mount_points.push_back({ mount_point, base_dir });
+            return true;
+        }
+
+        bool remove_mount_point(const std::string& mount_point) {
+            auto& mounts = config_->mount_points;
+            auto it = std::find_if(mounts.begin(), mounts.end(),
+                [&](const MountPoint& mount) { return mount.mount_point == mount_point; });
+            if (it == mounts.end()) {
+                return false;
+            }
+            mounts.erase(it);
+            return true;
+        }
+
+        // ùصСļڴ滺棺 max_file_size ļͬԤѹ汾ڴУܴС byte_budget
+        // preload Ϊ true ʱ Run() ԤĿ¼µļ Run() ֮ǰ
+        void set_asset_cache(size_t byte_budget, size_t max_file_size = CPPHTTPLIB_ASSET_CACHE_MAX_FILE_SIZE, bool preload = false) {
+            config_->asset_cache = std::make_shared<AssetCache>(byte_budget, max_file_size);
+            preload_assets_ = preload;
+        }
+
+        AssetCacheStats asset_cache_stats() const {
+            return config_->asset_cache ? config_->asset_cache->stats() : AssetCacheStats{};
+        }
+
+        // Ƿ Accept-Encoding ԶѹӦ壬ĬϿ CPPHTTPLIB_ZLIB_SUPPORT ʱЧ
+        void set_compress(bool enable) {
+            config_->compress = enable;
+        }
+
+        //  zlib ѹ0-9-1 ΪĬϼ
+        void set_compression_level(int level) {
+            config_->compression_level = level;
+        }
+
+        // ѹСӦ峤
+        void set_compress_min_size(size_t size) {
+            config_->compress_min_size = size;
+        }
+
+        // óӿгʱʱ
+        void set_keep_alive_timeout(std::chrono::seconds timeout) {
+            config_->keep_alive_timeout = timeout;
+        }
+
+        // ͷޣĵһֽڣӴӽʱʼ
+        void set_header_timeout(std::chrono::milliseconds timeout) {
+            config_->header_timeout = timeout;
+        }
+
+        // öȡʱĳʱʱ䣬ÿյݺ¼
+        void set_read_timeout(std::chrono::milliseconds timeout) {
+            config_->read_timeout = timeout;
+        }
+
+        // дӦʱĳʱʱ䣬ÿдݺ¼
+        void set_write_timeout(std::chrono::milliseconds timeout) {
+            config_->write_timeout = timeout;
         }
 
+        // ע·ɶᲢ֮ʹ·ɱڴӰ졣
+        // Run() ʱԶһΣ޸·ɺٴεüȸ¡
+        void commit_routes() {
+            routes_.publish(router_.freeze());
+        }
+
+        // 滻·ɲ
+        void set_routes(Router<Route> router) {
+            router_ = std::move(router);
+            commit_routes();
+        }
+
+        //  Stop() ã reactor ʱڵ߳У reactor ʱȴе߳˳
 		void Run() {
-			io_context_->run();
+            commit_routes();
+            start_asset_cache();
+            if (has_offload_routes_ && !config_->worker_pool) {
+                size_t threads = worker_threads_ > 0 ? worker_threads_ : (std::max)(1u, std::thread::hardware_concurrency());
+                config_->worker_pool = std::make_shared<ThreadPool>(threads);
+                owns_worker_pool_ = true;
+            }
+            if (!config_->admission && (config_->max_connections > 0 || config_->max_inflight_requests > 0 || config_->concurrency_limit)) {
+                config_->admission = std::make_shared<AdmissionControl>(config_->max_connections,
+                    config_->max_inflight_requests, config_->retry_after, config_->concurrency_limit);
+                config_->admission->set_capacity_handler([this]() { resume_accept(); });
+            }
+            if (pool_) {
+                pool_->setCpuAffinity(cpu_affinity_);
+                pool_->start();
+                pool_->join();
+            } else {
+                reactors_[0]->io_context->run();
+            }
 		}
 
+        // ֹͣ reactorRun() 󷵻أ̵߳
+        void Stop() {
+            if (pool_) {
+                pool_->stop();
+            } else {
+                for (auto& reactor : reactors_) {
+                    reactor->io_context->stop();
+                }
+            }
+        }
+
+        //  reactor  SessionPool ͳ֮
+        SessionPoolStats session_pool_stats() const {
+            SessionPoolStats total;
+            for (const auto& reactor : reactors_) {
+                SessionPoolStats stats = reactor->session_pool->stats();
+                total.hits += stats.hits;
+                total.misses += stats.misses;
+                total.dropped += stats.dropped;
+                total.idle += stats.idle;
+            }
+            return total;
+        }
+
+        size_t reactor_count() const {
+            return reactors_.size();
+        }
+
+        // ׼ƵͳƣδκʱȫΪ 0
+        AdmissionStats admission_stats() const {
+            return config_->admission ? config_->admission->stats() : AdmissionStats{};
+        }
+
     private:
-        asio::ip::tcp::acceptor acceptor_;
-        std::shared_ptr<IOContextWrapper> io_context_;
         std::function<void(Response&)> error_handler_;
-        std::shared_ptr<SessionPool> session_pool_;
-        std::unordered_map<std::string, Handler> handlers_;
+        std::shared_ptr<ServerConfig> config_;
+        short port_;
+        AcceptMode accept_mode_;
+        bool cpu_affinity_ = false;
+        bool preload_assets_ = false;
+        bool has_offload_routes_ = false;
+        bool owns_worker_pool_ = false;
+        size_t worker_threads_ = 0;
+        std::vector<std::unique_ptr<Reactor>> reactors_;
+        std::unique_ptr<IOContextPool> pool_;   //  reactor ģʽʹãʱ reactors_ ȴ߳˳
+        Router<Route> router_;              // ·ɹֻע·ɵ߳޸
+        RouteTableSlot<Route> routes_;      // ѷֻ·ɱ
 
-        void start_accept() {
-            acceptor_.async_accept([this](std::error_code ec, asio::ip::tcp::socket socket) {
-                if (!ec) {
-                    auto session = session_pool_->getSession(std::move(socket));
-                    //auto session = std::make_shared<Session>(std::move(socket), io_context_, error_handler_);
-                    session->setHandlerMap(handlers_);
+        Server& route(HttpMethod method, const std::string& pattern, Handler handler) {
+            router_.emplace(method, pattern).handler = std::move(handler);
+            return *this;
+        }
+
+        Server& route(HttpMethod method, const std::string& pattern, HandlerWithContentReader handler) {
+            router_.emplace(method, pattern).content_reader_handler = std::move(handler);
+            return *this;
+        }
+
+#if defined(ASIO_HAS_CO_AWAIT)
+        Server& route(HttpMethod method, const std::string& pattern, CoroutineHandler handler) {
+            router_.emplace(method, pattern).coroutine_handler = std::move(handler);
+            return *this;
+        }
+#endif
+
+        //  reactor 0 ϼӸĿ¼Ԥ
+        void start_asset_cache() {
+            if (!config_->asset_cache) {
+                return;
+            }
+            for (const auto& mount : config_->mount_points) {
+                config_->asset_cache->watch(*reactors_[0]->io_context->getContext(), mount.base_dir);
+                if (preload_assets_) {
+                    config_->asset_cache->preload(mount.base_dir);
+                }
+            }
+        }
+
+        Reactor& add_reactor(std::shared_ptr<IOContextWrapper> io_context) {
+            auto reactor = std::make_unique<Reactor>();
+            reactor->io_context = io_context;
+            reactor->session_pool = std::make_shared<SessionPool>(io_context, Server::errorHandlerFunc, config_);
+            reactors_.push_back(std::move(reactor));
+            return *reactors_.back();
+        }
+
+        std::unique_ptr<asio::ip::tcp::acceptor> make_acceptor(Reactor& reactor, bool reuse_port) {
+            asio::ip::tcp::endpoint endpoint(asio::ip::tcp::v4(), port_);
+            auto acceptor = std::make_unique<asio::ip::tcp::acceptor>(*reactor.io_context->getContext());
+            acceptor->open(endpoint.protocol());
+            acceptor->set_option(asio::ip::tcp::acceptor::reuse_address(true));
+#ifdef SO_REUSEPORT
+            if (reuse_port) {
+                using reuse_port_option = asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+                acceptor->set_option(reuse_port_option(true));
+            }
+#endif
+            acceptor->bind(endpoint);
+            acceptor->listen();
+            return acceptor;
+        }
+
+        //  reactor Լ߳ϴ session
+        void start_session(Reactor& reactor, asio::ip::tcp::socket socket) {
+            auto session = reactor.session_pool->getSession(std::move(socket));
+            session->setRoutes(&routes_);
+            session->start();
+        }
+
+        // ȴ SessionPool ȡ sessionֱӰӽܵ socket 
+        void start_accept(Reactor& reactor) {
+            std::shared_ptr<Session> session = reactor.session_pool->acquire();
+            reactor.acceptor->async_accept(session->socket(), [this, &reactor, session](std::error_code ec) {
+                if (!ec && !admit_connection(session->socket())) {
+                    reactor.session_pool->release(session);
+                } else if (!ec) {
+                    session->setRoutes(&routes_);
                     session->start();
-				} else {
+                } else {
+                    reactor.session_pool->release(session);
+                    if (ec == asio::error::operation_aborted) {
+                        return;
+                    }
 					std::cerr << "Error during async_accept: " << ec.message() << std::endl;
 				}
-                start_accept();
+                if (!pause_accept(reactor)) {
+                    start_accept(reactor);
+                }
             });
         }
 
-		 static void errorHandlerFunc(Response& response) {
-			response.setContent("Internal Server Error", "text/html");
-			response.setStatus(StatusCode::InternalServerError);
-		}
-    };
+        //  acceptor ӣsocket ֱӴĿ reactor  io_context ϣͶݹȥ
+        void start_accept_handoff() {
+            Reactor& target = select_reactor();
+            reactors_[0]->acceptor->async_accept(*target.io_context->getContext(),
+                [this, &target](std::error_code ec, asio::ip::tcp::socket socket) {
+                if (!ec && !admit_connection(socket)) {
+                    // ѽ OverloadRejector  503
+                } else if (!ec) {
+                    asio::post(*target.io_context->getContext(),
+                        [this, &target, socket = std::move(socket)]() mutable {
+                            start_session(target, std::move(socket));
+                        });
+				} else if (ec == asio::error::operation_aborted) {
+                    return;
+                } else {
+					std::cerr << "Error during async_accept: " << ec.message() << std::endl;
+				}
+                if (!pause_accept(*reactors_[0])) {
+                    start_accept_handoff();
+                }
+            });
+        }
+
+        // Ӽʱ socket  OverloadRejector  503 session
+        // ȴرյıܾҲﵽʱд 503 رա
+        // ʱ socket ֲ䣬ܾʱѱ߻ر
+        bool admit_connection(asio::ip::tcp::socket& socket) {
+            if (!config_->admission || config_->admission->try_acquire_connection()) {
+                return true;
+            }
+            if (config_->admission->try_acquire_rejector()) {
+                std::make_shared<OverloadRejector>(std::move(socket), config_->admission)->start();
+            } else {
+                asio::error_code ignored;
+                socket.non_blocking(true, ignored);
+                socket.write_some(asio::buffer(config_->admission->overload_response()), ignored);
+                socket.close(ignored);
+            }
+            return false;
+        }
 
+        // OverloadAction::Pause ´ﵽʱͣ accept true ʾ֮ͣ resume_accept ָ
+        // ͣڼں˵ backlog 
+        bool pause_accept(Reactor& reactor) {
+            if (!config_->admission || config_->overload_action != OverloadAction::Pause || !config_->admission->overloaded()) {
+                return false;
+            }
+            reactor.accept_paused.store(true);
+            if (!config_->admission->wait_for_capacity()) {
+                resume_accept();  // ǼڼѾָ
+            }
+            return true;
+        }
+
+        // пָͣ acceptorڸԵ reactor ¿ʼ accept̵߳
+        void resume_accept() {
+            for (auto& reactor : reactors_) {
+                if (reactor->accept_paused.exchange(false)) {
+                    Reactor* target = reactor.get();
+                    asio::post(*target->io_context->getContext(), [this, target]() {
+                        if (accept_mode_ == AcceptMode::ReusePort) {
+                            start_accept(*target);
+                        } else {
+                            start_accept_handoff();
+                        }
+                    });
+                }
+            }
+        }
 
+        // ѯ IOContextPool ± reactors_ һһӦ
+        Reactor& select_reactor() {
+            return *reactors_[pool_->getNextIndex()];
+        }
 
+		 static void errorHandlerFunc(Response& response) {
+			// ÷õ״̬룬ĬϵӦ
+			response.setContent(statusCodeToString(response.StatCde), "text/html");
+		}
+    };
 
     inline void Session::returnSession() {
+        io_context_->removeConnection();
+        cancel_admission();
+        if (config_->admission) {
+            config_->admission->release_connection();
+        }
+        asio::error_code ignored;
+        socket_.close(ignored);
         if (auto pool = pool_.lock()) {
-            socket_.close();
-            pool->returnSession(shared_from_this());
+            pool->release(shared_from_this());
         }
     }
 } // namespace http_asio
@@ -1,45 +1,406 @@
 #ifndef HTTP_THREAD_POOL_HPP
 #define HTTP_THREAD_POOL_HPP
 
+#include "const.hpp"
+
 #include <vector>
-#include <queue>
+#include <deque>
 #include <thread>
 #include <mutex>
-#include <condition_variable>
+#include <atomic>
 #include <functional>
 #include <future>
-#include <stop_token>
+#include <memory>
+#include <tuple>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 #include <iostream>
+#include <stdexcept>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
 
 namespace http_asio {
 
+    // ȴʱʾ CPU ͹ġóˮ߸̵߳һ
+    inline void cpu_relax() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    }
+
+    // ֻƶ񡣲 kInlineSize ĿɵöֱӴڶڲڴ棬
+    // ˿ֱӳ promiseunique_ptr ֻƶĶռһ
+    class Task {
+    public:
+        static constexpr size_t kInlineSize = 56;
+
+        Task() noexcept = default;
+
+        template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task>>>
+        Task(F&& f) {
+            using Fn = std::decay_t<F>;
+            if constexpr (fits_inline<Fn>()) {
+                ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(f));
+                ops_ = &kInlineOps<Fn>;
+            } else {
+                *reinterpret_cast<Fn**>(storage_) = new Fn(std::forward<F>(f));
+                ops_ = &kHeapOps<Fn>;
+            }
+        }
+
+        Task(Task&& other) noexcept {
+            move_from(other);
+        }
+
+        Task& operator=(Task&& other) noexcept {
+            if (this != &other) {
+                reset();
+                move_from(other);
+            }
+            return *this;
+        }
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        ~Task() {
+            reset();
+        }
+
+        explicit operator bool() const noexcept {
+            return ops_ != nullptr;
+        }
+
+        void operator()() {
+            ops_->invoke(storage_);
+        }
+
+        void reset() noexcept {
+            if (ops_) {
+                ops_->destroy(storage_);
+                ops_ = nullptr;
+            }
+        }
+
+    private:
+        struct Ops {
+            void (*invoke)(void*);
+            void (*move)(void* dst, void* src) noexcept;    // ƶ dst  src
+            void (*destroy)(void*) noexcept;
+        };
+
+        template <typename Fn>
+        static constexpr bool fits_inline() {
+            return sizeof(Fn) <= kInlineSize && alignof(Fn) <= alignof(std::max_align_t)
+                && std::is_nothrow_move_constructible_v<Fn>;
+        }
+
+        template <typename Fn>
+        static constexpr Ops kInlineOps = {
+            [](void* p) { (*static_cast<Fn*>(p))(); },
+            [](void* dst, void* src) noexcept {
+                ::new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+                static_cast<Fn*>(src)->~Fn();
+            },
+            [](void* p) noexcept { static_cast<Fn*>(p)->~Fn(); }
+        };
+
+        template <typename Fn>
+        static constexpr Ops kHeapOps = {
+            [](void* p) { (**static_cast<Fn**>(p))(); },
+            [](void* dst, void* src) noexcept { *static_cast<Fn**>(dst) = *static_cast<Fn**>(src); },
+            [](void* p) noexcept { delete *static_cast<Fn**>(p); }
+        };
+
+        alignas(std::max_align_t) unsigned char storage_[kInlineSize];
+        const Ops* ops_ = nullptr;
+
+        void move_from(Task& other) noexcept {
+            if (other.ops_) {
+                other.ops_->move(storage_, other.storage_);
+                ops_ = other.ops_;
+                other.ops_ = nullptr;
+            }
+        }
+    };
+
+    namespace detail {
+
+        constexpr size_t kCacheLineSize = 64;
+
+        class TaskNodePool;
+
+        // ̶߳еĽڵ㣬 TaskNodePool ո
+        struct TaskNode {
+            Task task;
+            TaskNode* next = nullptr;
+            TaskNodePool* owner = nullptr;      // ýڵĹ̵߳Ŀ
+        };
+
+        // ÿ߳һĽڵ̬ԼĶύ񲻷ڴ档
+        // ڵܱ߳ȡִУʱ黹̵߳ remote_ ջ
+        // remote_ ֻ߳ȡߣexchangeû˲ ABA 
+        class TaskNodePool {
+        public:
+            TaskNodePool() = default;
+            TaskNodePool(const TaskNodePool&) = delete;
+            TaskNodePool& operator=(const TaskNodePool&) = delete;
+
+            ~TaskNodePool() {
+                free_list(local_);
+                free_list(remote_.load(std::memory_order_acquire));
+            }
+
+            // ̵ֻ߳
+            TaskNode* acquire() {
+                if (!local_) {
+                    local_ = remote_.exchange(nullptr, std::memory_order_acquire);
+                }
+                if (!local_) {
+                    TaskNode* node = new TaskNode;
+                    node->owner = this;
+                    return node;
+                }
+                TaskNode* node = local_;
+                local_ = node->next;
+                return node;
+            }
+
+            // ̵ֻ߳
+            void release_local(TaskNode* node) {
+                node->next = local_;
+                local_ = node;
+            }
+
+            // ̵߳
+            void release_remote(TaskNode* node) {
+                TaskNode* head = remote_.load(std::memory_order_relaxed);
+                do {
+                    node->next = head;
+                } while (!remote_.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+            }
+
+        private:
+            TaskNode* local_ = nullptr;
+            alignas(kCacheLineSize) std::atomic<TaskNode*> remote_{ nullptr };
+
+            static void free_list(TaskNode* node) {
+                while (node) {
+                    TaskNode* next = node->next;
+                    delete node;
+                    node = next;
+                }
+            }
+        };
+
+        // Chase-Lev ȡ˫˶УL  2013  C11 ڴģͰ汾
+        // Ĺ߳ڵײ push/pop̴߳Ӷ stealʱ鱣
+        // ȡ߶ͷŵڴ档ȡ CAS ֮ǰҪȡԪأԪֻԭӵĽڵָ
+        class WorkStealingDeque {
+        public:
+            explicit WorkStealingDeque(size_t capacity = 256) {
+                arrays_.push_back(std::make_unique<Array>(capacity));
+                array_.store(arrays_.back().get(), std::memory_order_relaxed);
+            }
+
+            WorkStealingDeque(const WorkStealingDeque&) = delete;
+            WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+            // ̵ֻ߳
+            void push(TaskNode* task) {
+                int64_t b = bottom_.load(std::memory_order_relaxed);
+                int64_t t = top_.load(std::memory_order_acquire);
+                Array* a = array_.load(std::memory_order_relaxed);
+                if (b - t > a->capacity - 1) {
+                    a = grow(a, t, b);
+                }
+                a->put(b, task);
+                std::atomic_thread_fence(std::memory_order_release);
+                bottom_.store(b + 1, std::memory_order_relaxed);
+            }
+
+            // ̵ֻ߳ãȳ
+            TaskNode* pop() {
+                int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+                Array* a = array_.load(std::memory_order_relaxed);
+                bottom_.store(b, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                int64_t t = top_.load(std::memory_order_relaxed);
+
+                if (t > b) {
+                    bottom_.store(b + 1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+                TaskNode* task = a->get(b);
+                if (t == b) {
+                    // һԪأȡ߾
+                    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                        task = nullptr;
+                    }
+                    bottom_.store(b + 1, std::memory_order_relaxed);
+                }
+                return task;
+            }
+
+            // ̵߳ãȽȳȡ߾ʧʱ nullptr
+            TaskNode* steal() {
+                int64_t t = top_.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                int64_t b = bottom_.load(std::memory_order_acquire);
+                if (t >= b) {
+                    return nullptr;
+                }
+                Array* a = array_.load(std::memory_order_acquire);
+                TaskNode* task = a->get(t);
+                if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                    return nullptr;
+                }
+                return task;
+            }
+
+            bool empty() const {
+                int64_t b = bottom_.load(std::memory_order_relaxed);
+                int64_t t = top_.load(std::memory_order_relaxed);
+                return b <= t;
+            }
+
+        private:
+            struct Array {
+                explicit Array(size_t size)
+                    : capacity(static_cast<int64_t>(size)), mask(capacity - 1),
+                      slots(std::make_unique<std::atomic<TaskNode*>[]>(size)) {}
+
+                int64_t capacity;
+                int64_t mask;
+                std::unique_ptr<std::atomic<TaskNode*>[]> slots;
+
+                TaskNode* get(int64_t i) const { return slots[i & mask].load(std::memory_order_relaxed); }
+                void put(int64_t i, TaskNode* task) { slots[i & mask].store(task, std::memory_order_relaxed); }
+            };
+
+            alignas(kCacheLineSize) std::atomic<int64_t> top_{ 0 };
+            alignas(kCacheLineSize) std::atomic<int64_t> bottom_{ 0 };
+            std::atomic<Array*> array_;
+            std::vector<std::unique_ptr<Array>> arrays_;   // ֻ߳޸
+
+            Array* grow(Array* old, int64_t t, int64_t b) {
+                auto bigger = std::make_unique<Array>(static_cast<size_t>(old->capacity) * 2);
+                for (int64_t i = t; i < b; ++i) {
+                    bigger->put(i, old->get(i));
+                }
+                Array* raw = bigger.get();
+                arrays_.push_back(std::move(bigger));
+                array_.store(raw, std::memory_order_release);
+                return raw;
+            }
+        };
+
+        // Vyukov н߶߶У߳ύ̳߳ء
+        // Э鱣֤ͬһʱֻһ̷߳ĳӣֱӰֵڸ
+        class InjectionQueue {
+        public:
+            explicit InjectionQueue(size_t capacity)
+                : mask_(round_up(capacity) - 1), cells_(std::make_unique<Cell[]>(mask_ + 1)) {
+                for (size_t i = 0; i <= mask_; ++i) {
+                    cells_[i].sequence.store(i, std::memory_order_relaxed);
+                }
+            }
+
+            // ʱ falsetask ֲ
+            bool try_push(Task& task) {
+                size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+                Cell* cell;
+                for (;;) {
+                    cell = &cells_[pos & mask_];
+                    size_t seq = cell->sequence.load(std::memory_order_acquire);
+                    intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+                    if (diff == 0) {
+                        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                    }
+                    else if (diff < 0) {
+                        return false;
+                    }
+                    else {
+                        pos = enqueue_pos_.load(std::memory_order_relaxed);
+                    }
+                }
+                cell->task = std::move(task);
+                cell->sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+
+            bool try_pop(Task& task) {
+                size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+                Cell* cell;
+                for (;;) {
+                    cell = &cells_[pos & mask_];
+                    size_t seq = cell->sequence.load(std::memory_order_acquire);
+                    intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+                    if (diff == 0) {
+                        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                    }
+                    else if (diff < 0) {
+                        return false;
+                    }
+                    else {
+                        pos = dequeue_pos_.load(std::memory_order_relaxed);
+                    }
+                }
+                task = std::move(cell->task);
+                cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+                return true;
+            }
+
+            bool empty() const {
+                return enqueue_pos_.load(std::memory_order_relaxed) == dequeue_pos_.load(std::memory_order_relaxed);
+            }
+
+        private:
+            struct Cell {
+                std::atomic<size_t> sequence;
+                Task task;
+            };
+
+            static size_t round_up(size_t n) {
+                size_t size = 2;
+                while (size < n) size <<= 1;
+                return size;
+            }
+
+            size_t mask_;
+            std::unique_ptr<Cell[]> cells_;
+            alignas(kCacheLineSize) std::atomic<size_t> enqueue_pos_{ 0 };
+            alignas(kCacheLineSize) std::atomic<size_t> dequeue_pos_{ 0 };
+        };
+
+    } // namespace detail
+
+    // ȡ̳߳ء
+    // ÿ߳һ Chase-Lev ˫˶У߳ڲύԼĶУ߳ύ
+    // עУԺУе߳β鿴ԼĶСעк̵߳ĶУ
+    // ûߣύʱֻ߳ʱŻѣæʱϵͳá
     class ThreadPool {
     public:
         // 캯ʼ̳߳زָ߳
         explicit ThreadPool(size_t num_threads)
-            : stop_requested_(false) {
+            : injection_(CPPHTTPLIB_THREAD_POOL_QUEUE_SIZE),
+              // ֻһ CPU ʱֻռύ̵߳ʱ
+              spin_count_(std::thread::hardware_concurrency() > 1 ? CPPHTTPLIB_THREAD_POOL_SPIN_COUNT : 0) {
+            if (num_threads == 0) {
+                num_threads = 1;
+            }
             for (size_t i = 0; i < num_threads; ++i) {
-                threads_.emplace_back([this](std::stop_token stoken) {
-                    while (!stoken.stop_requested()) {
-                        std::function<void()> task;
-                        {
-                            // 
-                            std::unique_lock<std::mutex> lock(mutex_);
-                            condition_.wait(lock, [this, &stoken] {
-                                return stop_requested_ || !tasks_.empty();
-                                });
-
-                            if (stop_requested_ && tasks_.empty()) {
-                                return;
-                            }
-
-                            task = std::move(tasks_.front());
-                            tasks_.pop();
-                        }
-                        // ִ
-                        task();
-                    }
-                    });
+                workers_.push_back(std::make_unique<Worker>(static_cast<uint32_t>(i) * 2654435761u + 1));
+            }
+            for (size_t i = 0; i < num_threads; ++i) {
+                threads_.emplace_back([this, i]() { worker_loop(i); });
             }
         }
 
@@ -58,45 +419,210 @@ namespace http_asio {
             -> std::future<std::invoke_result_t<Func, Args...>> {
             using ReturnType = std::invoke_result_t<Func, Args...>;
 
-            auto task = std::make_shared<std::packaged_task<ReturnType()>>(
-                std::bind(std::forward<Func>(func), std::forward<Args>(args)...)
-            );
-
-            std::future<ReturnType> result = task->get_future();
-            {
-                std::unique_lock<std::mutex> lock(mutex_);
-                if (stop_requested_) {
-                    throw std::runtime_error("Submit on stopped ThreadPool");
+            // promise ɵöһ Task Уpackaged_task ѿɵöŵϵĹ״̬
+            std::promise<ReturnType> promise;
+            std::future<ReturnType> result = promise.get_future();
+            post([promise = std::move(promise), func = std::forward<Func>(func),
+                ... args = std::forward<Args>(args)]() mutable {
+                try {
+                    if constexpr (std::is_void_v<ReturnType>) {
+                        std::invoke(std::move(func), std::move(args)...);
+                        promise.set_value();
+                    } else {
+                        promise.set_value(std::invoke(std::move(func), std::move(args)...));
+                    }
+                } catch (...) {
+                    promise.set_exception(std::current_exception());
                 }
-                tasks_.emplace([task]() { (*task)(); });
-            }
-            condition_.notify_one();
+            });
             return result;
         }
 
-        // ֹ̳ͣ߳أֹ̲ͣ߳ȴ
+        // ύҪʡȥ promise  future Ŀ
+        // ɵö󲻳 Task::kInlineSize ʱ̬²ڴ
+        template<typename Func>
+        void post(Func&& func) {
+            // ִֹͣеԿԼύЩ߳˳ǰִ
+            if (stop_requested_.load(std::memory_order_acquire) && current_pool_ != this) {
+                throw std::runtime_error("Post on stopped ThreadPool");
+            }
+            Task task(std::forward<Func>(func));
+            if (current_pool_ == this) {
+                Worker& worker = *workers_[current_index_];
+                detail::TaskNode* node = worker.nodes.acquire();
+                node->task = std::move(task);
+                worker.deque.push(node);
+            }
+            else if (!injection_.try_push(task)) {
+                std::lock_guard<std::mutex> lock(overflow_mutex_);
+                overflow_.push_back(std::move(task));
+                overflow_size_.fetch_add(1, std::memory_order_relaxed);
+            }
+            wake_one();
+        }
+
+        size_t size() const {
+            return threads_.size();
+        }
+
+        // ֹ̳ͣ߳أٽύȫִ߳˳
         void stop() {
-            {
-                std::unique_lock<std::mutex> lock(mutex_);
-                stop_requested_ = true;
+            if (stop_requested_.exchange(true)) {
+                return;
             }
-            condition_.notify_all(); // ߳
+            epoch_.fetch_add(1, std::memory_order_release);
+            epoch_.notify_all(); // ߳
             for (auto& t : threads_) {
                 if (t.joinable()) {
-                    t.request_stop(); // ʹ std::jthread  stop 
                     t.join(); // ȴ߳
                 }
             }
+            //  stop ύ߳˳ӣڵǰ߳ 0 Ź̵ִ߳
+            ThreadPool* previous_pool = current_pool_;
+            size_t previous_index = current_index_;
+            current_pool_ = this;
+            current_index_ = 0;
+            Task task;
+            while (find_task(0, task)) {
+                run(task);
+            }
+            current_pool_ = previous_pool;
+            current_index_ = previous_index;
         }
 
     private:
-        std::vector<std::jthread> threads_;
-        std::queue<std::function<void()>> tasks_; // 
-        std::mutex mutex_; 
-        std::condition_variable_any condition_; 
-        bool stop_requested_; 
+        struct alignas(detail::kCacheLineSize) Worker {
+            explicit Worker(uint32_t seed) : rng(seed) {}
+
+            detail::WorkStealingDeque deque;
+            detail::TaskNodePool nodes;
+            uint32_t rng;   // ѡȡ״̬
+        };
+
+        std::vector<std::unique_ptr<Worker>> workers_;
+        std::vector<std::thread> threads_;
+        detail::InjectionQueue injection_;
+        std::mutex overflow_mutex_;
+        std::deque<Task> overflow_;
+        std::atomic<size_t> overflow_size_{ 0 };
+        alignas(detail::kCacheLineSize) std::atomic<uint32_t> epoch_{ 0 };     // ̵߳ȴ仯
+        alignas(detail::kCacheLineSize) std::atomic<uint32_t> sleepers_{ 0 };
+        std::atomic<bool> stop_requested_{ false };
+        int spin_count_;                    // ǰĴ
+
+        // ǰ̳߳߳غ͹߳±꣬ڰѹ߳ڲύԼĶ
+        static inline thread_local ThreadPool* current_pool_ = nullptr;
+        static inline thread_local size_t current_index_ = 0;
+
+        void worker_loop(size_t index) {
+            current_pool_ = this;
+            current_index_ = index;
+            Task task;
+            for (;;) {
+                bool found = find_task(index, task);
+                for (int spin = 0; !found && spin < spin_count_; ++spin) {
+                    cpu_relax();
+                    found = find_task(index, task);
+                }
+                if (found) {
+                    run(task);
+                    continue;
+                }
+                if (stop_requested_.load(std::memory_order_acquire)) {
+                    return;
+                }
+                park();
+            }
+        }
+
+        // ִкٿɵöͷ䲶Դ
+        static void run(Task& task) {
+            try {
+                task();
+            } catch (const std::exception& e) {
+                std::cerr << "Exception in thread pool task: " << e.what() << std::endl;
+            } catch (...) {
+            }
+            task.reset();
+        }
+
+        // ӽڵȡ񲢹黹ڵ㣺ԼĽڵŻرȡĽڵ㻹߳
+        void take(detail::TaskNode* node, Task& task) {
+            task = std::move(node->task);
+            detail::TaskNodePool* own = current_pool_ == this ? &workers_[current_index_]->nodes : nullptr;
+            if (node->owner == own) {
+                own->release_local(node);
+            } else {
+                node->owner->release_remote(node);
+            }
+        }
+
+        // β鿴ԼĶСעСУλÿʼȡ̵߳Ķ
+        bool find_task(size_t index, Task& task) {
+            Worker& self = *workers_[index];
+            if (detail::TaskNode* node = current_pool_ == this ? self.deque.pop() : nullptr) {
+                take(node, task);
+                return true;
+            }
+            if (injection_.try_pop(task)) {
+                return true;
+            }
+            if (overflow_size_.load(std::memory_order_relaxed) > 0) {
+                std::lock_guard<std::mutex> lock(overflow_mutex_);
+                if (!overflow_.empty()) {
+                    task = std::move(overflow_.front());
+                    overflow_.pop_front();
+                    overflow_size_.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            // xorshift32
+            self.rng ^= self.rng << 13;
+            self.rng ^= self.rng >> 17;
+            self.rng ^= self.rng << 5;
+            size_t count = workers_.size();
+            size_t start = self.rng % count;
+            for (size_t i = 0; i < count; ++i) {
+                size_t victim = (start + i) % count;
+                if (victim == index && current_pool_ == this) continue;
+                if (detail::TaskNode* node = workers_[victim]->deque.steal()) {
+                    take(node, task);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool has_work() const {
+            if (!injection_.empty() || overflow_size_.load(std::memory_order_relaxed) > 0) {
+                return true;
+            }
+            for (const auto& worker : workers_) {
+                if (!worker->deque.empty()) return true;
+            }
+            return false;
+        }
+
+        // ȵǼΪ߳ټһζУ wake_one Сټ̡߳ԣᶪʧ
+        void park() {
+            uint32_t epoch = epoch_.load(std::memory_order_acquire);
+            sleepers_.fetch_add(1, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!has_work() && !stop_requested_.load(std::memory_order_acquire)) {
+                epoch_.wait(epoch, std::memory_order_acquire);
+            }
+            sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        void wake_one() {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (sleepers_.load(std::memory_order_relaxed) > 0) {
+                epoch_.fetch_add(1, std::memory_order_release);
+                epoch_.notify_one();
+            }
+        }
     };
 
 } // namespace http_asio
 
-#endif // HTTP_THREAD_POOL_HPP
\ No newline at end of file
+#endif // HTTP_THREAD_POOL_HPP
@@ -0,0 +1,242 @@
+#ifndef HTTP_TIMER_WHEEL_HPP
+#define HTTP_TIMER_WHEEL_HPP
+
+#include "const.hpp"
+
+#include <asio.hpp>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace http_asio {
+
+    class TimerWheel;
+
+    // ʱϵһʱͨΪӶĳԱ
+    // ڵǶڶʱУúȡֻ O(1) ڴ棻ʱԶȡ
+    class TimerEntry {
+    public:
+        using Handler = std::function<void()>;
+
+        TimerEntry() = default;
+        explicit TimerEntry(Handler handler) : handler_(std::move(handler)) {}
+
+        TimerEntry(const TimerEntry&) = delete;
+        TimerEntry& operator=(const TimerEntry&) = delete;
+
+        ~TimerEntry() {
+            cancel();
+        }
+
+        void setHandler(Handler handler) {
+            handler_ = std::move(handler);
+        }
+
+        bool pending() const {
+            return wheel_ != nullptr;
+        }
+
+        inline void cancel();
+
+    private:
+        friend class TimerWheel;
+
+        Handler handler_;
+        TimerWheel* wheel_ = nullptr;       // ڵʱ֣δʱΪ
+        TimerEntry* prev_ = nullptr;
+        TimerEntry* next_ = nullptr;
+        uint64_t expires_ = 0;              // ڵ tick
+    };
+
+    // ֲʱ֣hierarchical timing wheelÿ reactor һֻڸ reactor ߳ʹã
+    //  LEVELS 㣬ÿ SLOTS ۣ L һ۸ SLOTS^L  tickʱʣʱӦĲ㣬
+    // ͲתһȦʱѸ߲㵱ǰеĶʱ·䵽Ͳ㡣áȡö O(1)
+    // ÿ tick ֻǰۣŵ޹ء
+    // ֻһ steady_timer  tick ƽʱΪʱֹͣƽھΪһ tick
+    class TimerWheel : public std::enable_shared_from_this<TimerWheel> {
+    public:
+        using clock_type = std::chrono::steady_clock;
+
+        TimerWheel(asio::io_context& io_context,
+            std::chrono::milliseconds tick = std::chrono::milliseconds(CPPHTTPLIB_TIMER_WHEEL_TICK_MSECOND))
+            : timer_(io_context), tick_((std::max)(tick, std::chrono::milliseconds(1))), start_(clock_type::now()) {
+            for (auto& level : wheels_) {
+                for (auto& slot : level) {
+                    slot.prev_ = slot.next_ = &slot;
+                }
+            }
+        }
+
+        TimerWheel(const TimerWheel&) = delete;
+        TimerWheel& operator=(const TimerWheel&) = delete;
+
+        ~TimerWheel() {
+            for (auto& level : wheels_) {
+                for (auto& slot : level) {
+                    while (slot.next_ != &slot) {
+                        unlink(slot.next_);
+                    }
+                }
+            }
+        }
+
+        //  timeout ֮ entry ĴõĶʱȱȡ
+        void schedule(TimerEntry& entry, clock_type::duration timeout) {
+            if (entry.wheel_) {
+                unlink(&entry);
+            }
+            if (size_ == 0) {
+                resume();
+            }
+            auto ticks = (timeout + tick_ - clock_type::duration(1)) / tick_;   // ȡһ tick
+            entry.expires_ = current_ + static_cast<uint64_t>((std::max)(ticks, decltype(ticks)(1)));
+            insert(&entry);
+            ++size_;
+            if (!ticking_) {
+                ticking_ = true;
+                arm();
+            }
+        }
+
+        void cancel(TimerEntry& entry) {
+            if (entry.wheel_ == this) {
+                unlink(&entry);
+            }
+        }
+
+        // ǰŵĶʱ
+        size_t size() const {
+            return size_;
+        }
+
+        std::chrono::milliseconds tick() const {
+            return tick_;
+        }
+
+    private:
+        static constexpr unsigned SLOT_BITS = 6;
+        static constexpr size_t SLOTS = size_t(1) << SLOT_BITS;
+        static constexpr size_t LEVELS = 4;                         // ɱʾ SLOTS^LEVELS  tickĬ tick Լ 19 
+        static constexpr uint64_t MAX_TICKS = (uint64_t(1) << (SLOT_BITS * LEVELS)) - 1;
+
+        // еĶʱڱΪͷ˫ѭ
+        std::array<std::array<TimerEntry, SLOTS>, LEVELS> wheels_;
+        asio::steady_timer timer_;
+        std::chrono::milliseconds tick_;
+        clock_type::time_point start_;      //  0  tick ʱ
+        uint64_t current_ = 0;              // Ѵ tick
+        size_t size_ = 0;
+        bool ticking_ = false;
+
+        // ʱ뵱ǰ tick Ĳֵѡ㣬ֵС SLOTS^(L+1) ķڵ L 
+        void insert(TimerEntry* entry) {
+            uint64_t delta = entry->expires_ - current_;
+            if (delta > MAX_TICKS) {
+                delta = MAX_TICKS;
+                entry->expires_ = current_ + delta;
+            }
+            size_t level = 0;
+            while (level + 1 < LEVELS && delta >= (uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+                ++level;
+            }
+            TimerEntry& slot = wheels_[level][(entry->expires_ >> (SLOT_BITS * level)) & (SLOTS - 1)];
+            entry->wheel_ = this;
+            entry->prev_ = slot.prev_;
+            entry->next_ = &slot;
+            slot.prev_->next_ = entry;
+            slot.prev_ = entry;
+        }
+
+        void unlink(TimerEntry* entry) {
+            entry->prev_->next_ = entry->next_;
+            entry->next_->prev_ = entry->prev_;
+            entry->prev_ = entry->next_ = nullptr;
+            entry->wheel_ = nullptr;
+            --size_;
+        }
+
+        // ʱΪʱûƽʹǰѵǰ tick 뵽
+        void resume() {
+            if (!ticking_) {
+                current_ = static_cast<uint64_t>((clock_type::now() - start_) / tick_);
+            }
+        }
+
+        void arm() {
+            timer_.expires_at(start_ + tick_ * static_cast<int64_t>(current_ + 1));
+            std::weak_ptr<TimerWheel> weak = weak_from_this();
+            timer_.async_wait([this, weak](std::error_code ec) {
+                if (ec) {
+                    return;
+                }
+                if (auto self = weak.lock()) {
+                    on_tick();
+                }
+            });
+        }
+
+        // ׷ϵǰʱ䣺 tick ƽÿ tick ȰѸ߲㵽ڵĲ·ţִе 0 㵱ǰеĶʱ
+        void on_tick() {
+            uint64_t target = static_cast<uint64_t>((clock_type::now() - start_) / tick_);
+            while (current_ < target && size_ > 0) {
+                ++current_;
+                for (size_t level = LEVELS - 1; level > 0; --level) {
+                    if ((current_ & ((uint64_t(1) << (SLOT_BITS * level)) - 1)) == 0) {
+                        cascade(level, (current_ >> (SLOT_BITS * level)) & (SLOTS - 1));
+                    }
+                }
+                expire(current_ & (SLOTS - 1));
+            }
+            if (size_ == 0) {
+                ticking_ = false;
+                return;
+            }
+            current_ = target;
+            arm();
+        }
+
+        void cascade(size_t level, size_t index) {
+            TimerEntry& slot = wheels_[level][index];
+            TimerEntry list;
+            if (slot.next_ == &slot) {
+                return;
+            }
+            // ժŻأŻʱͬһ
+            list.next_ = slot.next_;
+            list.prev_ = slot.prev_;
+            list.next_->prev_ = &list;
+            list.prev_->next_ = &list;
+            slot.prev_ = slot.next_ = &slot;
+            while (list.next_ != &list) {
+                TimerEntry* entry = list.next_;
+                list.next_ = entry->next_;
+                entry->next_->prev_ = &list;
+                insert(entry);
+            }
+            list.prev_ = list.next_ = nullptr;
+        }
+
+        // пûȡⶨʱÿζӲͷȡ
+        void expire(size_t index) {
+            TimerEntry& slot = wheels_[0][index];
+            while (slot.next_ != &slot) {
+                TimerEntry* entry = slot.next_;
+                unlink(entry);
+                if (entry->handler_) {
+                    entry->handler_();
+                }
+            }
+        }
+    };
+
+    inline void TimerEntry::cancel() {
+        if (wheel_) {
+            wheel_->cancel(*this);
+        }
+    }
+
+} // namespace http_asio
+
+#endif // HTTP_TIMER_WHEEL_HPP
@@ -1,19 +1,24 @@
 #ifndef HTTP_TYPES_HPP
 #define HTTP_TYPES_HPP
 
+#include "http_header.hpp"
+
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <memory_resource>
 #include <vector>
+#include <array>
 #include <optional>
 #include <sstream>
 
 namespace http_asio {
 
-    // HTTPͷͣʹunordered_map洢ͷֶκͶӦֵ
-    using Header = std::unordered_map<std::string, std::string>;
+    // ͷֶ Header  http_header.hpp 
 
-    // ѯͣ洢ֵʽĲѯ
-    using Param = std::unordered_map<std::string, std::string>;
+    // ѯͣ洢ֵʽĲѯ
+    // ڵͨ std::pmr 䣬˵ʹԼڴأõĶʹĬϵĶѷ
+    using Param = std::pmr::unordered_map<std::string, std::string>;
 
     enum class HttpMethod {
         GET,
@@ -29,7 +34,7 @@ namespace http_asio {
     };
 
     // ַתΪHttpMethodö
-    inline HttpMethod stringToHttpMethod(const std::string& method) {
+    inline HttpMethod stringToHttpMethod(std::string_view method) {
         if (method == "GET")     return HttpMethod::GET;
         if (method == "POST")    return HttpMethod::POST;
         if (method == "PUT")     return HttpMethod::PUT;
@@ -57,6 +62,21 @@ namespace http_asio {
         }
     }
 
+    // ݵȷRFC 9110 9.2.2ظ뷢һЧͬرʱԶ
+    inline bool isIdempotent(HttpMethod method) {
+        switch (method) {
+        case HttpMethod::GET:
+        case HttpMethod::HEAD:
+        case HttpMethod::OPTIONS:
+        case HttpMethod::TRACE:
+        case HttpMethod::PUT:
+        case HttpMethod::DEL:
+            return true;
+        default:
+            return false;
+        }
+    }
+
     // HTTP״̬ö
     enum class StatusCode {
         Continue = 100,
@@ -65,6 +85,7 @@ namespace http_asio {
         Created = 201,
         Accepted = 202,
         NoContent = 204,
+        PartialContent = 206,
         MovedPermanently = 301,
         Found = 302,
         NotModified = 304,
@@ -80,6 +101,7 @@ namespace http_asio {
         URITooLong = 414,
         UnsupportedMediaType = 415,
         RangeNotSatisfiable = 416,
+        RequestHeaderFieldsTooLarge = 431,
         InternalServerError = 500,
         NotImplemented = 501,
         BadGateway = 502,
@@ -98,6 +120,7 @@ namespace http_asio {
         case StatusCode::Created: return "201 Created";
         case StatusCode::Accepted: return "202 Accepted";
         case StatusCode::NoContent: return "204 No Content";
+        case StatusCode::PartialContent: return "206 Partial Content";
         case StatusCode::MovedPermanently: return "301 Moved Permanently";
         case StatusCode::Found: return "302 Found";
         case StatusCode::NotModified: return "304 Not Modified";
@@ -113,6 +136,7 @@ namespace http_asio {
         case StatusCode::URITooLong: return "414 URI Too Long";
         case StatusCode::UnsupportedMediaType: return "415 Unsupported Media Type";
         case StatusCode::RangeNotSatisfiable: return "416 Range Not Satisfiable";
+        case StatusCode::RequestHeaderFieldsTooLarge: return "431 Request Header Fields Too Large";
         case StatusCode::InternalServerError: return "500 Internal Server Error";
         case StatusCode::NotImplemented: return "501 Not Implemented";
         case StatusCode::BadGateway: return "502 Bad Gateway";
@@ -123,6 +147,22 @@ namespace http_asio {
         }
     }
 
+    // ״̬ "HTTP/1.1 200 OK\r\n"״εʱΪ״̬ɣ֮һֱЧδ֪״̬뷵ؿ
+    inline std::string_view statusLine(StatusCode status) {
+        static const std::array<std::string, 600> lines = [] {
+            std::array<std::string, 600> table;
+            for (int code = 100; code < 600; ++code) {
+                std::string text = statusCodeToString(static_cast<StatusCode>(code));
+                if (text != "0 Unknown") {
+                    table[code] = "HTTP/1.1 " + text + "\r\n";
+                }
+            }
+            return table;
+        }();
+        int code = static_cast<int>(status);
+        return (code >= 100 && code < 600) ? std::string_view(lines[code]) : std::string_view();
+    }
+
 
 
     // Content-Type
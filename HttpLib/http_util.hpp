@@ -3,7 +3,9 @@
 #define HTTP_UTIL_HPP
 
 #include "http_types.hpp"
+#include "http_scan.hpp"
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <unordered_map>
 #include <functional>
@@ -12,13 +14,15 @@
 #include <algorithm>
 #include <stdexcept>
 #include <iostream>
+#include <ctime>
+#include <cstdio>
 
 
 namespace http_asio {
 
-    // Ⱥݴĺ
-    using Progress = std::function<void(std::size_t, std::size_t)>;
-    using ContentReceiver = std::function<void(const std::string&)>;
+    // Ⱥݴĺͣ false ʱֹ
+    using Progress = std::function<bool(uint64_t current, uint64_t total)>;
+    using ContentReceiver = std::function<bool(const char* data, size_t data_length)>;
 
     // ж״̬
     // ɹ
@@ -57,17 +61,24 @@ namespace http_asio {
         return escaped.str();
     }
 
-    // URL 
-    inline std::string url_decode(const std::string& value) {
+    // URL 룬Ƿתԭplus_as_space ڲѯַе '+'
+    inline std::string url_decode(const std::string& value, bool plus_as_space = false) {
+        auto hex = [](char c) -> int {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        };
+
         std::string decoded;
+        decoded.reserve(value.size());
         for (size_t i = 0; i < value.size(); ++i) {
-            if (value[i] == '%') {
-                if (i + 2 < value.size()) {
-                    std::string hex = value.substr(i + 1, 2);
-                    char decoded_char = static_cast<char>(std::stoi(hex, nullptr, 16));
-                    decoded += decoded_char;
-                    i += 2;
-                }
+            if (value[i] == '%' && i + 2 < value.size() && hex(value[i + 1]) >= 0 && hex(value[i + 2]) >= 0) {
+                decoded += static_cast<char>(hex(value[i + 1]) * 16 + hex(value[i + 2]));
+                i += 2;
+            }
+            else if (plus_as_space && value[i] == '+') {
+                decoded += ' ';
             }
             else {
                 decoded += value[i];
@@ -76,26 +87,101 @@ namespace http_asio {
         return decoded;
     }
 
-    //  HTTP ͷ
-    inline Header parse_headers(const std::string& raw_headers) {
+    //  HTTP ͷ ':' У״̬Уᱻн
+    inline Header parse_headers(std::string_view raw_headers) {
         Header headers;
-        std::istringstream stream(raw_headers);
-        std::string line;
-
-        while (std::getline(stream, line) && !line.empty()) {
-            size_t separator = line.find(':');
-            if (separator != std::string::npos) {
-                std::string key = line.substr(0, separator);
-                std::string value = line.substr(separator + 1);
-                // ȥֵĿհַ
-                key.erase(std::remove_if(key.begin(), key.end(), isspace), key.end());
-                value.erase(std::remove_if(value.begin(), value.end(), isspace), value.end());
-                headers[key] = value;
+        const char* p = raw_headers.data();
+        const char* end = p + raw_headers.size();
+
+        while (p < end) {
+            const char* nl = scan::find_line_end(p, end);
+            const char* line_end = (nl > p && nl[-1] == '\r') ? nl - 1 : nl;
+            if (line_end == p) {
+                break;
             }
+
+            const char* colon = scan::find_first_of(p, line_end, ":");
+            if (colon != line_end) {
+                // ȥֵĿհַ
+                std::string_view key(p, static_cast<size_t>(colon - p));
+                std::string_view value(colon + 1, static_cast<size_t>(line_end - colon - 1));
+                while (!key.empty() && (key.back() == ' ' || key.back() == '\t')) key.remove_suffix(1);
+                while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) value.remove_prefix(1);
+                while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) value.remove_suffix(1);
+                headers.add(key, value);
+            }
+            p = nl == end ? end : nl + 1;
         }
         return headers;
     }
 
+    // ʽΪ HTTP-dateIMF-fixdate "Sun, 06 Nov 1994 08:49:37 GMT"дĳ
+    inline size_t format_http_date(std::time_t t, char* buf, size_t size) {
+        static const char* const days[] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+        static const char* const months[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+            "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+        std::tm tm{};
+#if defined(_WIN32)
+        gmtime_s(&tm, &t);
+#else
+        gmtime_r(&t, &tm);
+#endif
+        int n = std::snprintf(buf, size, "%s, %02d %s %04d %02d:%02d:%02d GMT", days[tm.tm_wday], tm.tm_mday,
+            months[tm.tm_mon], tm.tm_year + 1900, tm.tm_hour, tm.tm_min, tm.tm_sec);
+        return n > 0 ? static_cast<size_t>(n) : 0;
+    }
+
+    inline std::string format_http_date(std::time_t t) {
+        char buf[64];
+        return std::string(buf, format_http_date(t, buf, sizeof(buf)));
+    }
+
+    //  IMF-fixdate ʽ HTTP-dateʽʱ false
+    inline bool parse_http_date(std::string_view text, std::time_t& out) {
+        static const char* const months[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+            "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+        // "Sun, 06 Nov 1994 08:49:37 GMT"
+        if (text.size() != 29 || text.substr(3, 2) != ", " || text.substr(25) != " GMT") return false;
+        auto number = [&](size_t pos, size_t len, int& value) {
+            value = 0;
+            for (size_t i = pos; i < pos + len; ++i) {
+                if (text[i] < '0' || text[i] > '9') return false;
+                value = value * 10 + (text[i] - '0');
+            }
+            return true;
+        };
+        int day, year, hour, minute, second, month = -1;
+        for (int i = 0; i < 12; ++i) {
+            if (text.substr(8, 3) == months[i]) month = i + 1;
+        }
+        if (month < 0 || !number(5, 2, day) || !number(12, 4, year) || !number(17, 2, hour)
+            || !number(20, 2, minute) || !number(23, 2, second)) {
+            return false;
+        }
+        // תΪ 1970-01-01 
+        int y = month <= 2 ? year - 1 : year;
+        int era = (y >= 0 ? y : y - 399) / 400;
+        int yoe = y - era * 400;
+        int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        long long days = static_cast<long long>(era) * 146097 + doe - 719468;
+        out = static_cast<std::time_t>(days * 86400 + hour * 3600 + minute * 60 + second);
+        return true;
+    }
+
+    // ǰʱ HTTP-dateÿ߳ÿֻʽһΣͬһ reactor ϵӹ
+    inline std::string_view cached_http_date() {
+        thread_local std::time_t last = -1;
+        thread_local char buf[64];
+        thread_local size_t length = 0;
+        std::time_t now = std::time(nullptr);
+        if (now != last) {
+            last = now;
+            length = format_http_date(now, buf, sizeof(buf));
+        }
+        return std::string_view(buf, length);
+    }
+
     //  URL
     inline std::string join_url(const std::string& base, const std::string& path) {
         if (base.back() == '/' && path.front() == '/') {
@@ -113,8 +199,11 @@ namespace http_asio {
     }
 
     // ʾȱ
-    inline void report_progress(std::size_t current, std::size_t total) {
-        std::cout << "Progress: " << (current * 100 / total) << "% completed." << std::endl;
+    inline bool report_progress(uint64_t current, uint64_t total) {
+        if (total > 0) {
+            std::cout << "Progress: " << (current * 100 / total) << "% completed." << std::endl;
+        }
+        return true;
     }
 
 	inline void trim(std::string& str) {
@@ -0,0 +1,117 @@
+// /Ӧķ׼Ӽ pmr Դ Session ͬĬϵȫַԱȣ
+// ͬʱͳÿȫ operator new Ĵֱÿ½ͬһ clear 
+//   g++ -std=c++20 -O2 -I../HttpLib arena_bench.cpp -o arena_bench
+
+#include "bench.hpp"
+#include "http_arena.hpp"
+#include "http_request.hpp"
+#include "http_response.hpp"
+
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <string_view>
+#include <utility>
+
+namespace {
+    size_t allocations = 0;
+}
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+// std::pmr::new_delete_resource ʹôİ汾
+void* operator new(std::size_t size, std::align_val_t align) {
+    ++allocations;
+    std::size_t alignment = static_cast<std::size_t>(align);
+    if (void* p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace {
+
+    const std::pair<std::string_view, std::string_view> kHeaders[] = {
+        { "Host", "api.example.com" },
+        { "User-Agent", "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/120.0" },
+        { "Accept", "application/json, text/plain, */*" },
+        { "Accept-Language", "en-US,en;q=0.9" },
+        { "Accept-Encoding", "gzip, deflate, br, zstd" },
+        { "Connection", "keep-alive" },
+        { "Cookie", "session=8f14e45fceea167a5a36dedd4bea2543; theme=dark; lang=en" },
+        { "Referer", "https://www.example.com/account/orders" },
+        { "X-Request-Id", "7b0a6a52-44a5-4c4e-9f4e-6c8b7a1d2e3f" },
+    };
+
+    // һڣӦȻԱһ
+    void serve(http_asio::Request& request, http_asio::Response& response) {
+        request.clear();
+        request.Method = http_asio::HttpMethod::GET;
+        request.setTarget("/api/v1/users/12345/orders?limit=20&offset=40");
+        for (const auto& [name, value] : kHeaders) {
+            request.Headers.add(name, value);
+        }
+        response.clear();
+        response.setContent("{\"orders\":[]}", "application/json");
+        response.setHeader("Cache-Control", "no-store, max-age=0");
+        response.setHeader("X-Request-Id", *request.Headers.get("X-Request-Id"));
+        bench::keep(request.Headers.size() + response.Body.size());
+    }
+
+    template<typename Func>
+    void report_allocations(const char* name, Func&& func) {
+        for (int i = 0; i < 100; ++i) {
+            func();
+        }
+        size_t before = allocations;
+        const int requests = 10000;
+        for (int i = 0; i < requests; ++i) {
+            func();
+        }
+        std::printf("%-40s %12.2f allocations/request\n", name,
+            static_cast<double>(allocations - before) / requests);
+    }
+
+} // namespace
+
+int main() {
+    const size_t iterations = 500000;
+    std::pmr::unsynchronized_pool_resource pool;
+
+    auto fresh_heap = []() {
+        http_asio::Request request;
+        http_asio::Response response;
+        serve(request, response);
+    };
+    auto fresh_pooled = [&pool]() {
+        http_asio::Request request(&pool);
+        http_asio::Response response(&pool);
+        serve(request, response);
+    };
+    http_asio::Request heap_request;
+    http_asio::Response heap_response;
+    auto reused_heap = [&]() { serve(heap_request, heap_response); };
+    http_asio::Request pooled_request(&pool);
+    http_asio::Response pooled_response(&pool);
+    auto reused_pooled = [&]() { serve(pooled_request, pooled_response); };
+
+    report_allocations("new objects, global allocator", fresh_heap);
+    report_allocations("new objects, pool resource", fresh_pooled);
+    report_allocations("reused objects, global allocator", reused_heap);
+    report_allocations("reused objects, pool resource", reused_pooled);
+
+    bench::run("new objects, global allocator", iterations, fresh_heap);
+    bench::run("new objects, pool resource", iterations, fresh_pooled);
+    bench::run("reused objects, global allocator", iterations, reused_heap);
+    bench::run("reused objects, pool resource", iterations, reused_pooled);
+    return 0;
+}
@@ -0,0 +1,80 @@
+#ifndef HTTP_BENCH_HPP
+#define HTTP_BENCH_HPP
+
+// ׼Թõļʱߡ *_bench.cpp Ƕĳ򣬲Կܣ磺
+//   g++ -std=c++20 -O2 -I../HttpLib parser_bench.cpp -o parser_bench
+// Ҫ asio ѹĻ׼ļͷע˶ı
+
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <string>
+
+namespace bench {
+
+    // ֹŻ
+    inline volatile size_t sink = 0;
+
+    template <typename T>
+    inline void keep(const T& value) {
+        sink = sink + static_cast<size_t>(value);
+    }
+
+    // Ԥ iterations / 10 Σټʱ iterations Σӡÿβ
+    template <typename Func>
+    double run(const char* name, size_t iterations, Func&& func) {
+        for (size_t i = 0; i < iterations / 10; ++i) {
+            func();
+        }
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            func();
+        }
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        double ns = elapsed.count() / static_cast<double>(iterations);
+        std::printf("%-40s %12.1f ns/op\n", name, ns);
+        return ns;
+    }
+
+    // ӡbytes Ϊÿβֽ
+    template <typename Func>
+    double run_throughput(const char* name, size_t iterations, size_t bytes, Func&& func) {
+        for (size_t i = 0; i < (iterations + 9) / 10; ++i) {
+            func();
+        }
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            func();
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        double mbps = static_cast<double>(bytes) * static_cast<double>(iterations) / elapsed.count() / (1024.0 * 1024.0);
+        std::printf("%-40s %12.1f MB/s\n", name, mbps);
+        return mbps;
+    }
+
+    // ӽʵ API Ӧ JSON 飬Լ size ֽڣֶظֵַ¼仯
+    inline std::string json_payload(size_t size) {
+        static const char* const kStatus[] = { "pending", "paid", "shipped", "delivered", "cancelled" };
+        static const char* const kCity[] = { "Berlin", "Shanghai", "Toronto", "Lisbon", "Osaka", "Austin" };
+        std::string json = "{\"orders\":[";
+        unsigned seed = 12345;
+        for (size_t i = 0; json.size() < size; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            if (i > 0) json += ',';
+            json += "{\"id\":" + std::to_string(100000 + i)
+                + ",\"customer\":{\"id\":" + std::to_string(seed % 50000)
+                + ",\"name\":\"customer-" + std::to_string(seed % 9973)
+                + "\",\"city\":\"" + kCity[(seed >> 8) % 6]
+                + "\"},\"status\":\"" + kStatus[(seed >> 4) % 5]
+                + "\",\"total\":" + std::to_string(seed % 100000 / 100.0)
+                + ",\"items\":" + std::to_string(seed % 7 + 1)
+                + ",\"created_at\":\"2024-0" + std::to_string(seed % 9 + 1) + "-1" + std::to_string(seed % 10)
+                + "T08:" + std::to_string(10 + seed % 50) + ":00Z\"}";
+        }
+        json += "]}";
+        return json;
+    }
+
+} // namespace bench
+
+#endif // HTTP_BENCH_HPP
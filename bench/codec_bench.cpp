@@ -0,0 +1,67 @@
+// ݱԱȣgzipbrzstd ڲͬС JSON Ӧϵѹʡѹͽѹʹ÷Ĭϼ
+//   g++ -std=c++20 -O2 -DCPPHTTPLIB_ZLIB_SUPPORT -DCPPHTTPLIB_BROTLI_SUPPORT -DCPPHTTPLIB_ZSTD_SUPPORT -I../HttpLib codec_bench.cpp -o codec_bench -lz -lbrotlienc -lbrotlidec -lzstd
+// δõıᱻ
+
+#include "bench.hpp"
+#include "http_compress.hpp"
+
+#include <string>
+
+using namespace http_asio;
+
+namespace {
+
+    std::string compress_all(EncodingType type, const std::string& input) {
+        std::string output;
+        auto compressor = make_compressor(type);
+        compressor->compress(input.data(), input.size(), true, [&output](const char* data, size_t size) {
+            output.append(data, size);
+            return true;
+        });
+        return output;
+    }
+
+    size_t decompress_all(EncodingType type, const std::string& input) {
+        size_t total = 0;
+        auto decompressor = make_decompressor(type);
+        decompressor->decompress(input.data(), input.size(), [&total](const char*, size_t size) {
+            total += size;
+            return true;
+        });
+        return total;
+    }
+
+    void run_codecs(size_t size, size_t iterations) {
+        const std::string payload = bench::json_payload(size);
+        std::printf("-- %zu byte JSON\n", payload.size());
+        char name[64];
+        for (EncodingType type : { EncodingType::Gzip, EncodingType::Brotli, EncodingType::Zstd }) {
+            if (!encoding_supported(type)) {
+                std::printf("%-40s not enabled\n", encoding_name(type).data());
+                continue;
+            }
+            const std::string compressed = compress_all(type, payload);
+            if (decompress_all(type, compressed) != payload.size()) {
+                std::printf("%-40s round trip failed\n", encoding_name(type).data());
+                continue;
+            }
+            std::snprintf(name, sizeof(name), "%s compress (ratio %.2f)", encoding_name(type).data(),
+                static_cast<double>(payload.size()) / static_cast<double>(compressed.size()));
+            bench::run_throughput(name, iterations, payload.size(), [&]() {
+                bench::keep(compress_all(type, payload).size());
+            });
+            std::snprintf(name, sizeof(name), "%s decompress", encoding_name(type).data());
+            bench::run_throughput(name, iterations, payload.size(), [&]() {
+                bench::keep(decompress_all(type, compressed));
+            });
+        }
+    }
+
+} // namespace
+
+int main() {
+    run_codecs(2 * 1024, 2000);
+    run_codecs(64 * 1024, 200);
+    run_codecs(1024 * 1024, 10);
+    return 0;
+}
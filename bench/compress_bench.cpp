@@ -0,0 +1,79 @@
+// Ӧѹ׼gzip ѹµѹʣ CPPHTTPLIB_COMPRESS_CHUNK_SIZE ֶ
+//   g++ -std=c++20 -O2 -DCPPHTTPLIB_ZLIB_SUPPORT -I../HttpLib compress_bench.cpp -o compress_bench -lz
+// ԱÿӦ½ z_stream ߳ڵ StatePool 
+
+#include "bench.hpp"
+#include "http_compress.hpp"
+
+#include <algorithm>
+#include <string>
+#include <zlib.h>
+
+using namespace http_asio;
+
+namespace {
+
+    //  send_response ֶͬѹһνѹ
+    size_t compress_chunked(Compressor& compressor, const std::string& input) {
+        size_t total = 0;
+        auto sink = [&total](const char*, size_t size) {
+            total += size;
+            return true;
+        };
+        for (size_t offset = 0; offset < input.size(); offset += CPPHTTPLIB_COMPRESS_CHUNK_SIZE) {
+            size_t size = (std::min)(CPPHTTPLIB_COMPRESS_CHUNK_SIZE, input.size() - offset);
+            compressor.compress(input.data() + offset, size, offset + size == input.size(), sink);
+        }
+        return total;
+    }
+
+    size_t gzip_pooled(const std::string& input, int level) {
+        auto compressor = make_compressor(EncodingType::Gzip, level);
+        return compress_chunked(*compressor, input);
+    }
+
+    //  StatePoolÿ deflateInit2 / deflateEnd
+    size_t gzip_fresh(const std::string& input, int level) {
+        z_stream strm{};
+        deflateInit2(&strm, level, Z_DEFLATED, 31, 8, Z_DEFAULT_STRATEGY);
+        std::string output(deflateBound(&strm, static_cast<uLong>(input.size())), '\0');
+        strm.next_in = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(input.data()));
+        strm.avail_in = static_cast<uInt>(input.size());
+        strm.next_out = reinterpret_cast<Bytef*>(output.data());
+        strm.avail_out = static_cast<uInt>(output.size());
+        deflate(&strm, Z_FINISH);
+        size_t total = strm.total_out;
+        deflateEnd(&strm);
+        return total;
+    }
+
+} // namespace
+
+int main() {
+    const std::string large = bench::json_payload(1024 * 1024);
+    const std::string small = bench::json_payload(4 * 1024);
+    char name[64];
+
+    std::printf("-- %zu byte JSON, streamed in %zu byte chunks\n", large.size(), CPPHTTPLIB_COMPRESS_CHUNK_SIZE);
+    for (int level : { 1, 3, 6, 9 }) {
+        size_t compressed = gzip_pooled(large, level);
+        std::snprintf(name, sizeof(name), "gzip level %d (ratio %.2f)", level,
+            static_cast<double>(large.size()) / static_cast<double>(compressed));
+        bench::run_throughput(name, 20, large.size(), [&]() {
+            bench::keep(gzip_pooled(large, level));
+        });
+    }
+
+    std::printf("-- %zu byte JSON, z_stream per response\n", small.size());
+    for (int level : { 1, 6 }) {
+        std::snprintf(name, sizeof(name), "level %d, new z_stream", level);
+        bench::run(name, 5000, [&]() {
+            bench::keep(gzip_fresh(small, level));
+        });
+        std::snprintf(name, sizeof(name), "level %d, pooled z_stream", level);
+        bench::run(name, 5000, [&]() {
+            bench::keep(gzip_pooled(small, level));
+        });
+    }
+    return 0;
+}
@@ -0,0 +1,132 @@
+// ׼ RequestParser ԭȻ istream/getline ĽʽԱ
+//   g++ -std=c++20 -O2 -I../HttpLib parser_bench.cpp -o parser_bench
+
+#include "bench.hpp"
+#include "http_parser.hpp"
+
+#include <string>
+#include <sstream>
+#include <unordered_map>
+#include <cstring>
+
+namespace {
+
+    const char* const kRequest =
+        "GET /api/v1/users/12345/orders?limit=20&offset=40 HTTP/1.1\r\n"
+        "Host: api.example.com\r\n"
+        "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/120.0 Safari/537.36\r\n"
+        "Accept: application/json, text/plain, */*\r\n"
+        "Accept-Language: en-US,en;q=0.9\r\n"
+        "Accept-Encoding: gzip, deflate, br, zstd\r\n"
+        "Connection: keep-alive\r\n"
+        "Cookie: session=8f14e45fceea167a5a36dedd4bea2543; theme=dark; lang=en\r\n"
+        "Referer: https://www.example.com/account/orders\r\n"
+        "Cache-Control: no-cache\r\n"
+        "X-Request-Id: 7b0a6a52-44a5-4c4e-9f4e-6c8b7a1d2e3f\r\n"
+        "\r\n";
+
+    const char* const kChunkedRequest =
+        "POST /upload HTTP/1.1\r\n"
+        "Host: api.example.com\r\n"
+        "Transfer-Encoding: chunked\r\n"
+        "\r\n"
+        "10\r\n0123456789abcdef\r\n"
+        "10\r\n0123456789abcdef\r\n"
+        "8;ext=1\r\n01234567\r\n"
+        "0\r\n\r\n";
+
+    void trim(std::string& s) {
+        s.erase(0, s.find_first_not_of(" \t\r\n"));
+        s.erase(s.find_last_not_of(" \t\r\n") + 1);
+    }
+
+    // ԭ Session::parse_request getline Уistringstream Уÿͷ substr + trim  map
+    size_t parse_with_istream(const std::string& raw) {
+        std::stringbuf buffer(raw);
+        std::istream stream(&buffer);
+        std::string line;
+        std::getline(stream, line);
+        std::istringstream line_stream(line);
+        std::string method, uri;
+        line_stream >> method >> uri;
+
+        std::unordered_map<std::string, std::string> headers;
+        std::string header;
+        while (std::getline(stream, header) && header != "\r") {
+            size_t colon = header.find(':');
+            if (colon != std::string::npos) {
+                std::string key = header.substr(0, colon);
+                std::string value = header.substr(colon + 1);
+                trim(key);
+                trim(value);
+                headers[key] = value;
+            }
+        }
+        return method.size() + uri.size() + headers.size();
+    }
+
+    size_t parse_with_parser(http_asio::RequestParser& parser, const char* data, size_t size) {
+        parser.reset();
+        if (parser.parse(data, size) != http_asio::ParseStatus::HeadersComplete) {
+            return 0;
+        }
+        size_t total = parser.method().size() + parser.target().size();
+        for (size_t i = 0; i < parser.header_count(); ++i) {
+            total += parser.header_name(i).size() + parser.header_value(i).size();
+        }
+        return total;
+    }
+
+    // һյȫֽڵÿζӶϵ
+    size_t parse_byte_by_byte(http_asio::RequestParser& parser, const char* data, size_t size) {
+        parser.reset();
+        for (size_t n = 1; n <= size; ++n) {
+            if (parser.parse(data, n) == http_asio::ParseStatus::HeadersComplete) {
+                return parser.header_count();
+            }
+        }
+        return 0;
+    }
+
+    size_t parse_chunked(http_asio::RequestParser& parser, const char* data, size_t size) {
+        parser.reset();
+        if (parser.parse(data, size) != http_asio::ParseStatus::HeadersComplete) {
+            return 0;
+        }
+        size_t offset = parser.head_length();
+        size_t body = 0;
+        while (true) {
+            size_t consumed = 0;
+            std::string_view chunk;
+            http_asio::ParseStatus status = parser.parse_body(data + offset, size - offset, consumed, chunk);
+            offset += consumed;
+            if (status == http_asio::ParseStatus::BodyChunk) {
+                body += chunk.size();
+            } else {
+                return status == http_asio::ParseStatus::Complete ? body : 0;
+            }
+        }
+    }
+
+} // namespace
+
+int main() {
+    const size_t iterations = 500000;
+    std::string raw(kRequest);
+    http_asio::RequestParser parser;
+
+    double old_ns = bench::run("istream/getline (baseline)", iterations, [&]() {
+        bench::keep(parse_with_istream(raw));
+    });
+    double new_ns = bench::run("RequestParser", iterations, [&]() {
+        bench::keep(parse_with_parser(parser, raw.data(), raw.size()));
+    });
+    bench::run("RequestParser, resumed per byte", iterations / 50, [&]() {
+        bench::keep(parse_byte_by_byte(parser, raw.data(), raw.size()));
+    });
+    bench::run("RequestParser, chunked body", iterations, [&]() {
+        bench::keep(parse_chunked(parser, kChunkedRequest, std::strlen(kChunkedRequest)));
+    });
+    std::printf("speedup: %.1fx\n", old_ns / new_ns);
+    return 0;
+}
@@ -0,0 +1,98 @@
+// ·ƥ׼radix tree ·ɣRouteTableԭȵ "METHOD:path" ϣHttpLibtmp.hpp е regex бԱ
+//   g++ -std=c++20 -O2 -I../HttpLib router_bench.cpp -o router_bench
+// ϣֻܾȷƥ䣬ֻþ̬·regex бע˳ƥ
+
+#include "bench.hpp"
+#include "http_router.hpp"
+
+#include <regex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace http_asio;
+
+namespace {
+
+    std::string static_pattern(size_t i) {
+        return "/api/v1/resource" + std::to_string(i) + "/items";
+    }
+
+    std::string param_pattern(size_t i) {
+        return "/api/v1/resource" + std::to_string(i) + "/:id/detail";
+    }
+
+    std::string param_path(size_t i) {
+        return "/api/v1/resource" + std::to_string(i) + "/8731/detail";
+    }
+
+    // ":name"  ([^/]+) cpp-httplib ͬ
+    std::regex to_regex(const std::string& pattern) {
+        return std::regex(std::regex_replace(pattern, std::regex(":[A-Za-z_]+"), "([^/]+)"));
+    }
+
+    void run_with_routes(size_t count) {
+        std::printf("-- %zu static + %zu parameter routes\n", count, count);
+
+        Router<int> router;
+        std::unordered_map<std::string, int> map;
+        std::vector<std::pair<std::regex, int>> regexes;
+        for (size_t i = 0; i < count; ++i) {
+            router.emplace(HttpMethod::GET, static_pattern(i)) = static_cast<int>(i);
+            router.emplace(HttpMethod::GET, param_pattern(i)) = static_cast<int>(i);
+            map.emplace("GET:" + static_pattern(i), static_cast<int>(i));
+            regexes.emplace_back(to_regex(static_pattern(i)), static_cast<int>(i));
+            regexes.emplace_back(to_regex(param_pattern(i)), static_cast<int>(i));
+        }
+        auto table = router.freeze();
+
+        // ע·ɣregex бҪɨȫĿ
+        std::string static_path = static_pattern(count - 1);
+        std::string dynamic_path = param_path(count - 1);
+        std::string method = "GET";
+        PathParamList params;
+        const size_t iterations = 200000;
+
+        bench::run("unordered_map \"GET:\" + path (static)", iterations, [&]() {
+            std::string key = method + ':' + static_path;
+            auto it = map.find(key);
+            bench::keep(it != map.end() ? it->second : -1);
+        });
+        size_t regex_iterations = (std::max)(size_t(20), iterations / (count * 4));
+        bench::run("regex list (static)", regex_iterations, [&]() {
+            std::smatch match;
+            for (const auto& [pattern, value] : regexes) {
+                if (std::regex_match(static_path, match, pattern)) {
+                    bench::keep(value);
+                    break;
+                }
+            }
+        });
+        bench::run("regex list (parameter)", regex_iterations, [&]() {
+            std::smatch match;
+            for (const auto& [pattern, value] : regexes) {
+                if (std::regex_match(dynamic_path, match, pattern)) {
+                    bench::keep(value + match.size());
+                    break;
+                }
+            }
+        });
+        bench::run("RouteTable (static)", iterations, [&]() {
+            const int* value = table->find(HttpMethod::GET, static_path, params);
+            bench::keep(value ? *value : -1);
+        });
+        bench::run("RouteTable (parameter)", iterations, [&]() {
+            const int* value = table->find(HttpMethod::GET, dynamic_path, params);
+            bench::keep(value ? *value + params.size() : 0);
+        });
+    }
+
+} // namespace
+
+int main() {
+    for (size_t count : { size_t(10), size_t(100), size_t(1000) }) {
+        run_with_routes(count);
+    }
+    return 0;
+}
@@ -0,0 +1,187 @@
+// ̳߳ؾ׼ȡ ThreadPool ԭȵ mutex + condition_variable + std::queue<std::function> ̳߳ضԱȣ
+// ͳÿȫ operator new Ĵ
+//   g++ -std=c++20 -O2 -I../HttpLib thread_pool_bench.cpp -o thread_pool_bench -lpthread
+// ⲿ߳ͬʱύС񣻹߳ڲύfan-outsubmit ȴ future
+
+#include "bench.hpp"
+#include "http_thread_pool.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <new>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace {
+    std::atomic<size_t> allocations{ 0 };
+}
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+    // ԭ http_thread_pool.hpp еʵ֣̹߳һһ
+    class MutexPool {
+    public:
+        explicit MutexPool(size_t num_threads) {
+            for (size_t i = 0; i < num_threads; ++i) {
+                threads_.emplace_back([this]() {
+                    for (;;) {
+                        std::function<void()> task;
+                        {
+                            std::unique_lock<std::mutex> lock(mutex_);
+                            condition_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+                            if (stop_ && tasks_.empty()) {
+                                return;
+                            }
+                            task = std::move(tasks_.front());
+                            tasks_.pop();
+                        }
+                        task();
+                    }
+                });
+            }
+        }
+
+        ~MutexPool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            condition_.notify_all();
+            for (auto& t : threads_) {
+                t.join();
+            }
+        }
+
+        template <typename Func>
+        void post(Func&& func) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                tasks_.emplace(std::forward<Func>(func));
+            }
+            condition_.notify_one();
+        }
+
+        // ԭȵ submit ͬpackaged_task  shared_ptr ٰ std::function
+        template <typename Func>
+        auto submit(Func&& func) -> std::future<std::invoke_result_t<Func>> {
+            using ReturnType = std::invoke_result_t<Func>;
+            auto task = std::make_shared<std::packaged_task<ReturnType()>>(std::forward<Func>(func));
+            std::future<ReturnType> result = task->get_future();
+            post([task]() { (*task)(); });
+            return result;
+        }
+
+    private:
+        std::vector<std::thread> threads_;
+        std::queue<std::function<void()>> tasks_;
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        bool stop_ = false;
+    };
+
+    const size_t kWorkers = 4;
+    const size_t kProducers = 4;
+
+    void wait_for(const std::atomic<size_t>& done, size_t target) {
+        while (done.load(std::memory_order_acquire) < target) {
+            std::this_thread::yield();
+        }
+    }
+
+    // ִ func ӡÿĺʱͷ
+    template <typename Func>
+    void report(const char* name, size_t tasks, Func&& func) {
+        size_t before = allocations.load();
+        auto start = std::chrono::steady_clock::now();
+        func();
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        double per_task = static_cast<double>(allocations.load() - before) / static_cast<double>(tasks);
+        std::printf("%-40s %12.1f ns/task %8.2f allocations/task\n", name,
+            elapsed.count() / static_cast<double>(tasks), per_task);
+    }
+
+    // kProducers ⲿ߳ͬʱύ per_producer 
+    template <typename Pool>
+    void external_producers(Pool& pool, size_t per_producer) {
+        std::atomic<size_t> done{ 0 };
+        std::vector<std::thread> producers;
+        for (size_t p = 0; p < kProducers; ++p) {
+            producers.emplace_back([&]() {
+                for (size_t i = 0; i < per_producer; ++i) {
+                    pool.post([&done]() { done.fetch_add(1, std::memory_order_release); });
+                }
+            });
+        }
+        for (auto& t : producers) {
+            t.join();
+        }
+        wait_for(done, kProducers * per_producer);
+    }
+
+    // ÿڹ߳ύ fanout 
+    template <typename Pool>
+    void nested_fanout(Pool& pool, size_t roots, size_t fanout) {
+        std::atomic<size_t> done{ 0 };
+        for (size_t i = 0; i < roots; ++i) {
+            pool.post([&pool, &done, fanout]() {
+                for (size_t k = 0; k < fanout; ++k) {
+                    pool.post([&done]() { done.fetch_add(1, std::memory_order_release); });
+                }
+            });
+        }
+        wait_for(done, roots * fanout);
+    }
+
+    template <typename Pool>
+    void submit_round_trips(Pool& pool, size_t count) {
+        size_t sum = 0;
+        for (size_t i = 0; i < count; ++i) {
+            sum += pool.submit([i]() { return i; }).get();
+        }
+        bench::keep(sum);
+    }
+
+    template <typename Pool>
+    void run_all(const char* name, Pool& pool) {
+        std::printf("-- %s, %zu workers\n", name, kWorkers);
+        const size_t per_producer = 100000;
+        external_producers(pool, per_producer / 10);   // Ԥ
+        report("external producers", kProducers * per_producer, [&]() {
+            external_producers(pool, per_producer);
+        });
+        report("nested fan-out", 1000 * 100, [&]() {
+            nested_fanout(pool, 1000, 100);
+        });
+        report("submit + future::get", 20000, [&]() {
+            submit_round_trips(pool, 20000);
+        });
+    }
+
+} // namespace
+
+int main() {
+    {
+        MutexPool pool(kWorkers);
+        run_all("mutex + std::queue (baseline)", pool);
+    }
+    {
+        http_asio::ThreadPool pool(kWorkers);
+        run_all("work-stealing ThreadPool", pool);
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+// ׼ƣӦõӳꡢʱϴ룻
+// ʽ·ɣHandlerWithContentReaderṩӳͬͷŲ
+//   g++ -std=c++20 -O1 -I../HttpLib -I<asio ͷļĿ¼> admission_test.cpp -o admission_test -lpthread && ./admission_test
+
+#include "test.hpp"
+#include "test_client.hpp"
+#include "http_server.hpp"
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace http_asio;
+using namespace std::chrono_literals;
+
+namespace {
+
+    const unsigned short kPort = 18194;
+
+    // ¼յӳ޹̶
+    class RecordingLimit : public ConcurrencyLimit {
+    public:
+        size_t limit() const override {
+            return 64;
+        }
+
+        void update(std::chrono::nanoseconds latency, size_t) override {
+            std::lock_guard<std::mutex> lock(mutex_);
+            samples_.push_back(latency);
+        }
+
+        std::vector<std::chrono::nanoseconds> samples() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return samples_;
+        }
+
+    private:
+        std::mutex mutex_;
+        std::vector<std::chrono::nanoseconds> samples_;
+    };
+
+    // ȷͷһ壬ͣ upload_pause ٷʣಿ
+    std::optional<test::RawResponse> slow_post(const std::string& path, std::chrono::milliseconds upload_pause) {
+        test::RawClient client(kPort);
+        const std::string body(1000, 'u');
+        client.send("POST " + path + " HTTP/1.1\r\nHost: localhost\r\nContent-Length: " + std::to_string(body.size())
+            + "\r\n\r\n" + body.substr(0, 500));
+        std::this_thread::sleep_for(upload_pause);
+        client.send(body.substr(500));
+        return client.read_response();
+    }
+
+} // namespace
+
+int main() {
+    auto limit = std::make_shared<RecordingLimit>();
+    Server server(kPort);
+    server.Post("/work", [](const Request& req, Response& res) {
+        std::this_thread::sleep_for(50ms);
+        res.setContent(std::to_string(req.Body.size()), "text/plain");
+    });
+    server.Post("/stream", [](const Request&, Response& res, const ContentReader& reader) {
+        auto size = std::make_shared<size_t>(0);
+        reader([size, &res](const char*, size_t length) {
+            *size += length;
+            res.setContent(std::to_string(*size), "text/plain");
+            return true;
+        });
+    });
+    server.set_concurrency_limit(limit);
+    std::thread reactor([&server]() { server.Run(); });
+
+    auto work = slow_post("/work", 400ms);
+    CHECK(work && work->status == 200 && work->body == "1000");
+    auto samples = limit->samples();
+    CHECK(samples.size() == 1);
+    // ֻ 50 msϴ 400 ms ͣ
+    CHECK(!samples.empty() && samples[0] >= 50ms && samples[0] < 300ms);
+
+    auto stream = slow_post("/stream", 200ms);
+    CHECK(stream && stream->status == 200 && stream->body == "1000");
+    CHECK(limit->samples().size() == 1);
+    CHECK(server.admission_stats().inflight == 0);
+
+    server.Stop();
+    reactor.join();
+    return TEST_RESULT();
+}
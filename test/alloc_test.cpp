@@ -0,0 +1,124 @@
+// ̬´󲻵ȫ operator newͬһԤȣͳ reactor ߳ϵķ
+//   g++ -std=c++20 -O1 -I../HttpLib -I<asio ͷļĿ¼> alloc_test.cpp -o alloc_test -lpthread && ./alloc_test
+
+#include "test.hpp"
+#include "http_server.hpp"
+
+#include <asio.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <thread>
+
+namespace {
+    std::atomic<bool> counting{ false };
+    std::atomic<size_t> allocations{ 0 };
+    thread_local bool reactor_thread = false;
+
+    void* counted_alloc(std::size_t size) {
+        if (reactor_thread && counting.load(std::memory_order_relaxed)) {
+            allocations.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (void* p = std::malloc(size ? size : 1)) {
+            return p;
+        }
+        throw std::bad_alloc();
+    }
+
+    void* counted_aligned_alloc(std::size_t size, std::align_val_t align) {
+        if (reactor_thread && counting.load(std::memory_order_relaxed)) {
+            allocations.fetch_add(1, std::memory_order_relaxed);
+        }
+        std::size_t alignment = static_cast<std::size_t>(align);
+        if (void* p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)) {
+            return p;
+        }
+        throw std::bad_alloc();
+    }
+}
+
+void* operator new(std::size_t size) { return counted_alloc(size); }
+void* operator new[](std::size_t size) { return counted_alloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+// std::pmr::new_delete_resource ʹôİ汾
+void* operator new(std::size_t size, std::align_val_t align) { return counted_aligned_alloc(size, align); }
+void* operator new[](std::size_t size, std::align_val_t align) { return counted_aligned_alloc(size, align); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace {
+
+    const short kPort = 18190;
+
+    const std::string kRequest =
+        "GET /users/42?fields=name&sort=asc HTTP/1.1\r\n"
+        "Host: localhost\r\n"
+        "User-Agent: alloc-test/1.0\r\n"
+        "Accept: application/json\r\n"
+        "Accept-Language: en-US,en;q=0.9\r\n"
+        "Cookie: session=8f14e45fceea167a5a36dedd4bea2543\r\n"
+        "X-Request-Id: 7b0a6a52-44a5-4c4e-9f4e-6c8b7a1d2e3f\r\n"
+        "\r\n";
+
+    //  count 󲢶ȫӦյӦ
+    size_t send_requests(asio::ip::tcp::socket& socket, size_t count) {
+        size_t received = 0;
+        std::string buffer;
+        char data[8192];
+        for (size_t i = 0; i < count; ++i) {
+            asio::write(socket, asio::buffer(kRequest));
+            // Ӧ̶Ϊ "ok"ͷֽΪһӦ
+            while (true) {
+                size_t end = buffer.find("\r\n\r\n");
+                if (end != std::string::npos && buffer.size() >= end + 6) {
+                    buffer.erase(0, end + 6);
+                    ++received;
+                    break;
+                }
+                size_t n = socket.read_some(asio::buffer(data));
+                buffer.append(data, n);
+            }
+        }
+        return received;
+    }
+
+} // namespace
+
+int main() {
+    using namespace http_asio;
+
+    Server server(kPort);
+    server.Get("/users/:id", [](const Request& req, Response& res) {
+        res.setContent(req.getPathParam("id") ? "ok" : "no", "application/json");
+    });
+    server.set_keep_alive_max_count(1000000);
+    std::thread reactor([&server]() {
+        reactor_thread = true;
+        server.Run();
+    });
+
+    asio::io_context io_context;
+    asio::ip::tcp::socket socket(io_context);
+    socket.connect(asio::ip::tcp::endpoint(asio::ip::make_address("127.0.0.1"), kPort));
+
+    // Ԥȣarena  asio  handler 涼ȶС
+    CHECK(send_requests(socket, 2000) == 2000);
+
+    counting = true;
+    CHECK(send_requests(socket, 10000) == 10000);
+    counting = false;
+
+    std::printf("allocations on the reactor thread for 10000 requests: %zu\n", allocations.load());
+    CHECK(allocations.load() == 0);
+
+    socket.close();
+    server.Stop();
+    reactor.join();
+    return TEST_RESULT();
+}
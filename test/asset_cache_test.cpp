@@ -0,0 +1,94 @@
+// AssetCacheСļ״кڴ淵أ max_file_size ļֻ¼һΣ֮ٴ򿪣
+// invalidate  ttl ļ仯ʱ룻״ֻһ߳
+//   g++ -std=c++20 -O1 -DCPPHTTPLIB_ZLIB_SUPPORT -I../HttpLib -I<asio ͷļĿ¼> asset_cache_test.cpp -o asset_cache_test -lpthread -lz && ./asset_cache_test
+
+#include "test.hpp"
+#include "http_asset_cache.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace http_asio;
+
+namespace {
+
+    void write_file(const std::filesystem::path& path, const std::string& content) {
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << content;
+    }
+
+    std::string body_of(const std::shared_ptr<const Asset>& asset) {
+        return asset ? asset->select("").body : std::string();
+    }
+
+} // namespace
+
+int main() {
+    const auto dir = std::filesystem::temp_directory_path() / "asset_cache_test_www";
+    std::filesystem::create_directories(dir);
+    const std::string small = (dir / "small.json").generic_string();
+    const std::string large = (dir / "large.bin").generic_string();
+    write_file(small, std::string(2000, 'a'));
+    write_file(large, std::string(5000, 'b'));
+
+    {
+        AssetCache cache(1 << 20, 4096, std::chrono::milliseconds(50));
+
+        auto first = cache.get(small);
+        CHECK(body_of(first) == std::string(2000, 'a'));
+        CHECK(cache.get(small) == first);
+        CHECK(cache.stats().hits == 1 && cache.stats().misses == 1);
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+        CHECK(first->select("gzip").body.size() < 2000);
+#endif
+
+        // ļһʱ¼ֱ֮ӷ nullptrΪҲټΪδ
+        CHECK(!cache.get(large));
+        CHECK(!cache.get(large));
+        CHECK(cache.stats().misses == 2 && cache.stats().hits == 1);
+        CHECK(cache.stats().entries == 2);
+
+        // ʧЧ
+        write_file(small, std::string(3000, 'c'));
+        cache.invalidate(small);
+        CHECK(body_of(cache.get(small)) == std::string(3000, 'c'));
+
+        // ttl  statļС뻺
+        write_file(large, "now small");
+        std::this_thread::sleep_for(std::chrono::milliseconds(60));
+        CHECK(body_of(cache.get(large)) == "now small");
+
+        // ڵļ¼
+        CHECK(!cache.get((dir / "missing.txt").generic_string()));
+        CHECK(cache.stats().entries == 2);
+    }
+
+    {
+        // ״У߳õ nullptr sendfile ·Դļֻһ
+        AssetCache cache;
+        std::atomic<bool> go{ false };
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 8; ++i) {
+            threads.emplace_back([&]() {
+                while (!go.load()) {
+                    std::this_thread::yield();
+                }
+                auto asset = cache.get(small);
+                CHECK(!asset || body_of(asset) == std::string(3000, 'c'));
+            });
+        }
+        go.store(true);
+        for (auto& t : threads) {
+            t.join();
+        }
+        CHECK(cache.stats().misses == 1);
+        CHECK(cache.get(small) != nullptr);
+    }
+
+    std::filesystem::remove_all(dir);
+    return TEST_RESULT();
+}
@@ -0,0 +1,105 @@
+// ѹϴ壺Decompressor::is_complete ѹͱضϵѹ
+// յضϵ gzip ʱ 400Ѳݽ
+//   g++ -std=c++20 -O1 -DCPPHTTPLIB_ZLIB_SUPPORT -I../HttpLib -I<asio ͷļĿ¼> decompress_test.cpp -o decompress_test -lpthread -lz && ./decompress_test
+// ͬʱ CPPHTTPLIB_BROTLI_SUPPORT / CPPHTTPLIB_ZSTD_SUPPORT ʱһ br  zstd
+
+#include "test.hpp"
+#include "test_client.hpp"
+#include "http_server.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+using namespace http_asio;
+
+namespace {
+
+    const unsigned short kPort = 18192;
+
+    std::string compressed(EncodingType type, const std::string& input) {
+        std::string output;
+        compress(type, input, output, false);
+        return output;
+    }
+
+    // 룬 decompress ǷɹԼ is_complete Ľ
+    bool feed(EncodingType type, std::string_view data, bool& complete) {
+        auto decompressor = make_decompressor(type);
+        auto sink = [](const char*, size_t) { return true; };
+        size_t half = data.size() / 2;
+        bool ok = decompressor->decompress(data.data(), half, sink)
+            && decompressor->decompress(data.data() + half, data.size() - half, sink);
+        complete = decompressor->is_complete();
+        return ok;
+    }
+
+    void detects_truncation(EncodingType type) {
+        const std::string payload = std::string(50000, 'x') + "tail";
+        const std::string full = compressed(type, payload);
+        CHECK(!full.empty());
+
+        bool complete = false;
+        CHECK(feed(type, full, complete) && complete);
+        // ȥĩβֽڣݱûдֻûн
+        CHECK(feed(type, std::string_view(full).substr(0, full.size() - 4), complete) && !complete);
+        CHECK(feed(type, std::string_view(full).substr(0, full.size() / 2), complete) && !complete);
+    }
+
+    std::string post(const std::string& body, const std::string& encoding) {
+        return "POST /upload HTTP/1.1\r\nHost: localhost\r\nContent-Encoding: " + encoding
+            + "\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+    }
+
+    void server_rejects_truncated_upload(std::atomic<int>& handled) {
+        const std::string payload(20000, 'y');
+        const std::string full = compressed(EncodingType::Gzip, payload);
+
+        {
+            test::RawClient client(kPort);
+            CHECK(client.send(post(full, "gzip")));
+            auto response = client.read_response();
+            CHECK(response && response->status == 200 && response->body == std::to_string(payload.size()));
+        }
+        {
+            test::RawClient client(kPort);
+            CHECK(client.send(post(full.substr(0, full.size() - 8), "gzip")));
+            auto response = client.read_response();
+            CHECK(response && response->status == 400);
+            CHECK(client.closed_by_peer());
+        }
+        // յûпɼѹճ
+        {
+            test::RawClient client(kPort);
+            CHECK(client.send(post("", "gzip")));
+            auto response = client.read_response();
+            CHECK(response && response->status == 200 && response->body == "0");
+        }
+        CHECK(handled.load() == 2);
+    }
+
+} // namespace
+
+int main() {
+    detects_truncation(EncodingType::Gzip);
+#ifdef CPPHTTPLIB_BROTLI_SUPPORT
+    detects_truncation(EncodingType::Brotli);
+#endif
+#ifdef CPPHTTPLIB_ZSTD_SUPPORT
+    detects_truncation(EncodingType::Zstd);
+#endif
+
+    std::atomic<int> handled{ 0 };
+    Server server(kPort);
+    server.Post("/upload", [&handled](const Request& req, Response& res) {
+        ++handled;
+        res.setContent(std::to_string(req.Body.size()), "text/plain");
+    });
+    std::thread reactor([&server]() { server.Run(); });
+
+    server_rejects_truncated_upload(handled);
+
+    server.Stop();
+    reactor.join();
+    return TEST_RESULT();
+}
@@ -0,0 +1,123 @@
+// ̬ļRange ͷĸд׺ΧԽ緵 416last < firstΧ
+// ·淶صӳ䣨"..", "%2e%2e", '\\', NUL  base_dir"/static" ƥ "/staticfoo"
+//   g++ -std=c++20 -O1 -I../HttpLib file_test.cpp -o file_test && ./file_test
+
+#include "test.hpp"
+#include "http_file.hpp"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace http_asio;
+
+namespace {
+
+    RangeResult range(std::string_view value, uint64_t size, ByteRange& out) {
+        out = ByteRange{};
+        return parse_byte_range(value, size, out);
+    }
+
+    bool satisfiable(std::string_view value, uint64_t size, uint64_t offset, uint64_t length) {
+        ByteRange out;
+        return range(value, size, out) == RangeResult::Satisfiable && out.offset == offset && out.length == length;
+    }
+
+    RangeResult result(std::string_view value, uint64_t size) {
+        ByteRange out;
+        return range(value, size, out);
+    }
+
+    void byte_ranges() {
+        CHECK(satisfiable("bytes=0-99", 1000, 0, 100));
+        CHECK(satisfiable("bytes=100-", 1000, 100, 900));
+        // last ļСʱضϵĩβ
+        CHECK(satisfiable("bytes=900-5000", 1000, 900, 100));
+        CHECK(satisfiable("bytes=999-999", 1000, 999, 1));
+
+        // ׺Χ N ֽڣN ļʱΪļ
+        CHECK(satisfiable("bytes=-100", 1000, 900, 100));
+        CHECK(satisfiable("bytes=-5000", 1000, 0, 1000));
+        CHECK(result("bytes=-0", 1000) == RangeResult::Unsatisfiable);
+        CHECK(result("bytes=-10", 0) == RangeResult::Unsatisfiable);
+
+        // first >= size
+        CHECK(result("bytes=1000-", 1000) == RangeResult::Unsatisfiable);
+        CHECK(result("bytes=1000-1200", 1000) == RangeResult::Unsatisfiable);
+        CHECK(result("bytes=0-", 0) == RangeResult::Unsatisfiable);
+
+        // last < first ķΧЧ Range Ӧ
+        CHECK(result("bytes=500-100", 1000) == RangeResult::None);
+
+        // Χ֧
+        CHECK(result("bytes=0-10,20-30", 1000) == RangeResult::None);
+        CHECK(result("bytes=-10, -20", 1000) == RangeResult::None);
+
+        // ʽ
+        CHECK(result("items=0-10", 1000) == RangeResult::None);
+        CHECK(result("bytes=10", 1000) == RangeResult::None);
+        CHECK(result("bytes=a-10", 1000) == RangeResult::None);
+        CHECK(result("bytes=0-1x", 1000) == RangeResult::None);
+        CHECK(result("bytes=-", 1000) == RangeResult::None);
+        CHECK(result("bytes=99999999999999999999-", 1000) == RangeResult::None);
+    }
+
+    std::optional<std::string> normalized(std::string_view path) {
+        std::string out;
+        if (!normalize_path(path, out)) return std::nullopt;
+        return out;
+    }
+
+    void normalize() {
+        CHECK(normalized("/a/b/c.txt") == "/a/b/c.txt");
+        CHECK(normalized("//a///b/./c.txt") == "/a/b/c.txt");
+        CHECK(normalized("/a/b/../c.txt") == "/a/c.txt");
+        CHECK(normalized("/a/b/") == "/a/b/");
+        CHECK(normalized("") == "/");
+        CHECK(normalized("/") == "/");
+        CHECK(normalized("/a/..") == "/");
+
+        CHECK(!normalized("/.."));
+        CHECK(!normalized("/a/../../etc/passwd"));
+        CHECK(!normalized("/a\\..\\..\\etc"));
+        CHECK(!normalized(std::string_view("/a\0b", 4)));
+        // "..." ֻͨļ
+        CHECK(normalized("/.../x") == "/.../x");
+    }
+
+    void resolve() {
+        std::vector<MountPoint> mounts{ { "/static", "/srv/www" }, { "/assets/", "/srv/assets" } };
+
+        CHECK(resolve_file_path(mounts, "/static/css/site.css") == "/srv/www/css/site.css");
+        CHECK(resolve_file_path(mounts, "/static") == "/srv/www/index.html");
+        CHECK(resolve_file_path(mounts, "/static/") == "/srv/www/index.html");
+        CHECK(resolve_file_path(mounts, "/static/docs/") == "/srv/www/docs/index.html");
+        CHECK(resolve_file_path(mounts, "/static/a%20b.txt") == "/srv/www/a b.txt");
+        CHECK(resolve_file_path(mounts, "/assets/app.js") == "/srv/assets/app.js");
+
+        // ǰ׺ֻڶα߽ƥ
+        CHECK(!resolve_file_path(mounts, "/staticfoo"));
+        CHECK(!resolve_file_path(mounts, "/staticfoo/a.txt"));
+        CHECK(!resolve_file_path(mounts, "/other/a.txt"));
+
+        // Ŀ¼Խ ".."ٷֺű ".."бܺ NUL
+        CHECK(!resolve_file_path(mounts, "/static/../secret.txt"));
+        CHECK(!resolve_file_path(mounts, "/static/a/../../secret.txt"));
+        CHECK(!resolve_file_path(mounts, "/static/%2e%2e/secret.txt"));
+        CHECK(!resolve_file_path(mounts, "/static/%2E%2E/%2e%2e/etc/passwd"));
+        CHECK(!resolve_file_path(mounts, "/static/..%2fsecret.txt"));
+        CHECK(!resolve_file_path(mounts, "/static/..\\secret.txt"));
+        CHECK(!resolve_file_path(mounts, "/static/%5c..%5csecret.txt"));
+        CHECK(!resolve_file_path(mounts, "/static/a.txt%00.png"));
+        // ڹصڲ
+        CHECK(resolve_file_path(mounts, "/static/a/%2e%2e/b.txt") == "/srv/www/b.txt");
+    }
+
+} // namespace
+
+int main() {
+    byte_ranges();
+    normalize();
+    resolve();
+    return TEST_RESULT();
+}
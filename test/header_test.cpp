@@ -0,0 +1,141 @@
+// Header ƽֶԴСдֶͬζֵset øֵǡremove
+// Լֶ kInlineCapacity ʱĲҡɾ˳
+//   g++ -std=c++20 -O1 -I../HttpLib header_test.cpp -o header_test && ./header_test
+
+#include "test.hpp"
+#include "http_header.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace http_asio;
+
+namespace {
+
+    void case_insensitive_lookup() {
+        Header headers;
+        headers.add("Content-Type", "text/html");
+        headers.add("X-Custom", "1");
+        CHECK(headers.get("content-type") == "text/html");
+        CHECK(headers.get("CONTENT-TYPE") == "text/html");
+        CHECK(headers.get(HeaderId::ContentType) == "text/html");
+        CHECK(headers.has(HeaderId::ContentType));
+        CHECK(headers.get("x-custom") == "1");
+        CHECK(!headers.get("X-Custom2"));
+        CHECK(!headers.has(HeaderId::ContentLength));
+        // ԭʼд
+        CHECK(headers.name(0) == "Content-Type");
+    }
+
+    void multi_value() {
+        Header headers;
+        headers.add("Set-Cookie", "a=1");
+        headers.add("Host", "example.com");
+        headers.add("set-cookie", "b=2");
+        headers.add("SET-COOKIE", "c=3");
+        CHECK(headers.count("Set-Cookie") == 3);
+        CHECK(headers.get("Set-Cookie") == "a=1");
+        auto values = headers.getAll("set-cookie");
+        CHECK(values == (std::vector<std::string_view>{ "a=1", "b=2", "c=3" }));
+        CHECK(headers.size() == 4);
+    }
+
+    void set_existing() {
+        Header headers;
+        headers.add("Cache-Control", "no-cache");
+        headers.add("Accept", "*/*");
+        headers.add("Cache-Control", "private");
+
+        // ֵ׷ӵĩβֶͬαɾֶβӰ
+        headers.set("cache-control", "public, max-age=31536000, immutable");
+        CHECK(headers.count("Cache-Control") == 1);
+        CHECK(headers.get(HeaderId::CacheControl) == "public, max-age=31536000, immutable");
+        CHECK(headers.get("Accept") == "*/*");
+        CHECK(headers.size() == 2);
+
+        // ̵ֵԭظ
+        headers.set("Cache-Control", "no-store");
+        CHECK(headers.get("Cache-Control") == "no-store");
+        CHECK(headers.get("Accept") == "*/*");
+
+        headers.set("X-New", "1");
+        CHECK(headers.get("x-new") == "1");
+        CHECK(headers.size() == 3);
+    }
+
+    void remove_fields() {
+        Header headers;
+        headers.add("Connection", "keep-alive");
+        headers.add("X-A", "1");
+        headers.add("connection", "upgrade");
+        headers.add("X-B", "2");
+        CHECK(headers.remove("CONNECTION"));
+        CHECK(!headers.has("Connection"));
+        CHECK(!headers.has(HeaderId::Connection));
+        CHECK(!headers.remove("Connection"));
+        CHECK(headers.size() == 2);
+        CHECK(headers.name(0) == "X-A" && headers.name(1) == "X-B");
+
+        headers.clear();
+        CHECK(headers.empty() && !headers.has("X-A"));
+        headers.add("X-C", "3");
+        CHECK(headers.get("X-C") == "3" && headers.size() == 1);
+    }
+
+    // ֶη overflow_ Уҡsetremove ͱҪ߽
+    void spill_past_inline_capacity() {
+        const size_t total = Header::kInlineCapacity + 8;
+        Header headers;
+        for (size_t i = 0; i < total; ++i) {
+            headers.add("X-Field-" + std::to_string(i), std::to_string(i));
+        }
+        CHECK(headers.size() == total);
+        for (size_t i = 0; i < total; ++i) {
+            CHECK(headers.get("x-field-" + std::to_string(i)) == std::to_string(i));
+        }
+
+        // еĳֶҲܰҵ
+        headers.add("Content-Length", "42");
+        CHECK(headers.has(HeaderId::ContentLength));
+        CHECK(headers.get(HeaderId::ContentLength) == "42");
+
+        // ɾеֶΣֶǰƣ˳򲻱
+        CHECK(headers.remove("X-Field-3"));
+        CHECK(headers.size() == total);
+        size_t expected = 0;
+        for (auto [name, value] : headers) {
+            if (expected == 3) ++expected;
+            if (expected == total) {
+                CHECK(name == "Content-Length");
+                break;
+            }
+            CHECK(name == "X-Field-" + std::to_string(expected));
+            CHECK(value == std::to_string(expected));
+            ++expected;
+        }
+
+        headers.set("X-Field-20", "a much longer value than before");
+        CHECK(headers.get("X-Field-20") == "a much longer value than before");
+        CHECK(headers.remove("Content-Length"));
+        CHECK(!headers.has(HeaderId::ContentLength));
+        CHECK(headers.size() == total - 1);
+
+        // clear ֮
+        headers.clear();
+        for (size_t i = 0; i < total; ++i) {
+            headers.add("Y-" + std::to_string(i), "v");
+        }
+        CHECK(headers.size() == total && headers.get("y-" + std::to_string(total - 1)) == "v");
+        CHECK(!headers.has("X-Field-0"));
+    }
+
+} // namespace
+
+int main() {
+    case_insensitive_lookup();
+    multi_value();
+    set_existing();
+    remove_fields();
+    spill_past_inline_capacity();
+    return TEST_RESULT();
+}
@@ -0,0 +1,55 @@
+// RequestParser ķ֡Transfer-Encoding бжϣ Content-Length ͬʱʱ
+//   g++ -std=c++20 -O1 -I../HttpLib parser_test.cpp -o parser_test && ./parser_test
+
+#include "test.hpp"
+#include "http_parser.hpp"
+
+#include <string>
+
+using namespace http_asio;
+
+namespace {
+
+    ParseStatus parse_head(const std::string& headers, RequestParser& parser) {
+        std::string raw = "POST /upload HTTP/1.1\r\nHost: example.com\r\n" + headers + "\r\n";
+        parser.reset();
+        return parser.parse(raw.data(), raw.size());
+    }
+
+    bool accepted_as_chunked(const std::string& headers) {
+        RequestParser parser;
+        return parse_head(headers, parser) == ParseStatus::HeadersComplete && parser.is_chunked();
+    }
+
+    bool rejected(const std::string& headers) {
+        RequestParser parser;
+        return parse_head(headers, parser) == ParseStatus::Error;
+    }
+
+} // namespace
+
+int main() {
+    CHECK(accepted_as_chunked("Transfer-Encoding: chunked\r\n"));
+    CHECK(accepted_as_chunked("Transfer-Encoding: CHUNKED\r\n"));
+    CHECK(accepted_as_chunked("Transfer-Encoding: gzip , chunked\r\n"));
+    CHECK(accepted_as_chunked("Transfer-Encoding: gzip\r\nTransfer-Encoding: chunked\r\n"));
+
+    // ֻ׺ед
+    CHECK(rejected("Transfer-Encoding: xchunked\r\n"));
+    CHECK(rejected("Transfer-Encoding: gzipchunked\r\n"));
+    // chunked ظʱ޷ȷϢ峤
+    CHECK(rejected("Transfer-Encoding: chunked, gzip\r\n"));
+    CHECK(rejected("Transfer-Encoding: chunked, chunked\r\n"));
+    CHECK(rejected("Transfer-Encoding: ,\r\n"));
+    // Content-Length  Transfer-Encoding ͬʱ֣˽
+    CHECK(rejected("Content-Length: 5\r\nTransfer-Encoding: chunked\r\n"));
+    CHECK(rejected("Transfer-Encoding: chunked\r\nContent-Length: 5\r\n"));
+    // Content-Length һ
+    CHECK(rejected("Content-Length: 5\r\nContent-Length: 6\r\n"));
+
+    RequestParser parser;
+    CHECK(parse_head("Content-Length: 5\r\n", parser) == ParseStatus::HeadersComplete);
+    CHECK(!parser.is_chunked() && parser.content_length() == 5);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,130 @@
+// ˮУһдˮм Connection: closeͬһ HEAD ֮ GET
+// Լ߳еúĿӦд
+//   g++ -std=c++20 -O1 -I../HttpLib -I<asio ͷļĿ¼> pipeline_test.cpp -o pipeline_test -lpthread && ./pipeline_test
+
+#include "test.hpp"
+#include "test_client.hpp"
+#include "http_server.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+using namespace http_asio;
+
+namespace {
+
+    const unsigned short kPort = 18191;
+
+    std::string get(const std::string& path, const std::string& extra = "") {
+        return "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n" + extra + "\r\n";
+    }
+
+    void several_requests_in_one_write() {
+        test::RawClient client(kPort);
+        CHECK(client.connected());
+        std::string batch;
+        for (int i = 0; i < 10; ++i) {
+            batch += get("/echo/" + std::to_string(i));
+        }
+        CHECK(client.send(batch));
+        for (int i = 0; i < 10; ++i) {
+            auto response = client.read_response();
+            CHECK(response && response->status == 200 && response->body == std::to_string(i));
+        }
+        CHECK(!client.closed_by_peer(std::chrono::milliseconds(100)));
+    }
+
+    // close ֮ǰӦ֮󱻶Ӧдӹر
+    void close_in_the_middle() {
+        test::RawClient client(kPort);
+        CHECK(client.send(get("/echo/a") + get("/echo/b", "Connection: close\r\n") + get("/echo/c")));
+        auto first = client.read_response();
+        CHECK(first && first->body == "a" && first->header("Connection") == "keep-alive");
+        auto second = client.read_response();
+        CHECK(second && second->body == "b" && second->header("Connection") == "close");
+        CHECK(client.closed_by_peer());
+    }
+
+    // HEAD ӦֻͷContent-Length  GET ͬ GET Ӧܴλ
+    void head_then_get() {
+        test::RawClient client(kPort);
+        CHECK(client.send("HEAD /static/hello.txt HTTP/1.1\r\nHost: localhost\r\n\r\n" + get("/static/hello.txt")
+            + get("/echo/after")));
+        auto head = client.read_response(true);
+        CHECK(head && head->status == 200 && head->header("Content-Length") == "11" && head->body.empty());
+        auto file = client.read_response();
+        CHECK(file && file->status == 200 && file->body == "hello world");
+        auto response = client.read_response();
+        CHECK(response && response->body == "after");
+    }
+
+    // ڹִ߳У reactor ϾӦ԰˳д
+    void ordered_across_offload() {
+        test::RawClient client(kPort);
+        CHECK(client.send(get("/slow") + get("/echo/fast") + get("/slow") + get("/echo/last")));
+        const char* expected[] = { "slow", "fast", "slow", "last" };
+        for (const char* body : expected) {
+            auto response = client.read_response();
+            CHECK(response && response->body == body);
+        }
+    }
+
+    // 󱻲Ƭε
+    void split_across_reads() {
+        test::RawClient client(kPort);
+        std::string batch = get("/echo/x") + get("/echo/y");
+        for (char c : batch) {
+            CHECK(client.send(std::string(1, c)));
+        }
+        auto x = client.read_response();
+        auto y = client.read_response();
+        CHECK(x && x->body == "x");
+        CHECK(y && y->body == "y");
+    }
+
+    // ͷʹһҲ 431ر
+    void oversized_header_in_one_write() {
+        test::RawClient client(kPort);
+        std::string pad(CPPHTTPLIB_HEADER_MAX_LENGTH, 'x');
+        CHECK(client.send(get("/echo/big", "X-Pad: " + pad + "\r\n")));
+        auto response = client.read_response();
+        CHECK(response && response->status == 431);
+        CHECK(client.closed_by_peer());
+    }
+
+} // namespace
+
+int main() {
+    const auto dir = std::filesystem::temp_directory_path() / "pipeline_test_www";
+    std::filesystem::create_directories(dir);
+    std::ofstream(dir / "hello.txt", std::ios::binary) << "hello world";
+
+    Server server(kPort);
+    server.Get("/echo/:text", [](const Request& req, Response& res) {
+        res.setContent(*req.getPathParam("text"), "text/plain");
+    });
+    server.Get("/slow", [](const Request&, Response& res) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        res.setContent("slow", "text/plain");
+    });
+    server.set_execution_policy(HttpMethod::GET, "/slow", ExecutionPolicy::Offload);
+    server.set_mount_point("/static", dir.string());
+    server.set_worker_threads(2);
+    server.set_keep_alive_max_count(100);
+    std::thread reactor([&server]() { server.Run(); });
+
+    several_requests_in_one_write();
+    close_in_the_middle();
+    head_then_get();
+    ordered_across_offload();
+    split_across_reads();
+    oversized_header_in_one_write();
+
+    server.Stop();
+    reactor.join();
+    std::filesystem::remove_all(dir);
+    return TEST_RESULT();
+}
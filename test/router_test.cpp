@@ -0,0 +1,73 @@
+// Router Ĳޣ":name"  "*name" κϼƳ PathParamList::kMaxParams ·עʱܾ
+// עɹƥʱ
+//   g++ -std=c++20 -O1 -I../HttpLib router_test.cpp -o router_test && ./router_test
+
+#include "test.hpp"
+#include "http_router.hpp"
+
+#include <stdexcept>
+#include <string>
+
+using namespace http_asio;
+
+namespace {
+
+    // count Σwith_wildcard ʱ׷һͨ
+    std::string pattern_with(size_t count, bool with_wildcard) {
+        std::string pattern;
+        for (size_t i = 0; i < count; ++i) {
+            pattern += "/p" + std::to_string(i) + "/:v" + std::to_string(i);
+        }
+        if (with_wildcard) {
+            pattern += "/rest/*tail";
+        }
+        return pattern;
+    }
+
+    bool registers(Router<int>& router, const std::string& pattern) {
+        try {
+            router.emplace(HttpMethod::GET, pattern) = 1;
+            return true;
+        }
+        catch (const std::invalid_argument&) {
+            return false;
+        }
+    }
+
+    // ʵ·ÿεֵΪ "x<i>"
+    std::string path_with(size_t count, bool with_wildcard) {
+        std::string path;
+        for (size_t i = 0; i < count; ++i) {
+            path += "/p" + std::to_string(i) + "/x" + std::to_string(i);
+        }
+        if (with_wildcard) {
+            path += "/rest/a/b";
+        }
+        return path;
+    }
+
+} // namespace
+
+int main() {
+    const size_t max = PathParamList::kMaxParams;
+    Router<int> router;
+
+    CHECK(registers(router, pattern_with(max, false)));
+    CHECK(registers(router, pattern_with(max - 1, true)));
+    CHECK(!registers(router, pattern_with(max + 1, false)));
+    CHECK(!registers(router, pattern_with(max, true)));
+    // ھ̬ǰ׺֮дͬ
+    CHECK(!registers(router, "/a:a/b:b/c:c/d:d/e:e/f:f/g:g/h:h/i:i"));
+    CHECK(router.size() == 2);
+
+    auto table = router.freeze();
+    PathParamList params;
+    CHECK(table->find(HttpMethod::GET, path_with(max, false), params) != nullptr);
+    CHECK(params.size() == max && params.name(max - 1) == "v" + std::to_string(max - 1));
+    CHECK(table->find(HttpMethod::GET, path_with(max - 1, true), params) != nullptr);
+    CHECK(params.size() == max && params.name(max - 1) == "tail");
+    // ܾ·û¿ƥĽڵ
+    CHECK(table->find(HttpMethod::GET, path_with(max + 1, false), params) == nullptr);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,25 @@
+#ifndef HTTP_TEST_HPP
+#define HTTP_TEST_HPP
+
+// Թõļꡣ *_test.cpp Ƕĳȫͨʱ 0磺
+//   g++ -std=c++20 -O1 -I../HttpLib parser_test.cpp -o parser_test && ./parser_test
+
+#include <cstdio>
+
+namespace test {
+    inline int failures = 0;
+}
+
+#define CHECK(expr)                                                                     \
+    do {                                                                                \
+        if (!(expr)) {                                                                  \
+            std::printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #expr);        \
+            ++test::failures;                                                           \
+        }                                                                               \
+    } while (0)
+
+#define TEST_RESULT()                                                                   \
+    (test::failures == 0 ? (std::printf("all checks passed\n"), 0)                     \
+                         : (std::printf("%d check(s) failed\n", test::failures), 1))
+
+#endif // HTTP_TEST_HPP
@@ -0,0 +1,134 @@
+#ifndef HTTP_TEST_CLIENT_HPP
+#define HTTP_TEST_CLIENT_HPP
+
+// Թõʽͻˣֱ socket շԭʼֽڣ Content-Length зӦ
+// ڼˮߡӹرյЭϸڡҪ asio ͷļ磺
+//   g++ -std=c++20 -O1 -I../HttpLib -I<asio ͷļĿ¼> pipeline_test.cpp -o pipeline_test -lpthread
+
+#include <asio.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <thread>
+
+namespace test {
+
+    struct RawResponse {
+        int status = 0;
+        std::string head;       // ״̬кͷβĿ
+        std::string body;
+
+        // ͷֶεִֵСд̶д
+        std::optional<std::string> header(const std::string& name) const {
+            size_t pos = head.find("\r\n" + name + ": ");
+            if (pos == std::string::npos) {
+                return std::nullopt;
+            }
+            pos += name.size() + 4;
+            return head.substr(pos, head.find("\r\n", pos) - pos);
+        }
+    };
+
+    class RawClient {
+    public:
+        // һ߳ʧʱ
+        explicit RawClient(unsigned short port) : socket_(io_context_) {
+            asio::ip::tcp::endpoint endpoint(asio::ip::make_address("127.0.0.1"), port);
+            for (int attempt = 0;; ++attempt) {
+                asio::error_code ec;
+                socket_.connect(endpoint, ec);
+                connected_ = !ec;
+                if (connected_ || attempt == 50) {
+                    break;
+                }
+                socket_.close();
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            }
+        }
+
+        bool connected() const {
+            return connected_;
+        }
+
+        asio::ip::tcp::socket& socket() {
+            return socket_;
+        }
+
+        bool send(const std::string& data) {
+            asio::error_code ec;
+            asio::write(socket_, asio::buffer(data), ec);
+            return !ec;
+        }
+
+        // ȡһӦhead_only  HEAD 󣬴ʱ Content-Length Ϣ塣
+        // ӹرջݲʱؿ
+        std::optional<RawResponse> read_response(bool head_only = false) {
+            size_t end;
+            while ((end = buffer_.find("\r\n\r\n")) == std::string::npos) {
+                if (!fill()) return std::nullopt;
+            }
+            RawResponse response;
+            response.head = buffer_.substr(0, end);
+            buffer_.erase(0, end + 4);
+            response.status = std::atoi(response.head.c_str() + 9);
+            size_t length = 0;
+            if (auto value = response.header("Content-Length"); value && !head_only) {
+                length = static_cast<size_t>(std::stoull(*value));
+            }
+            while (buffer_.size() < length) {
+                if (!fill()) return std::nullopt;
+            }
+            response.body = buffer_.substr(0, length);
+            buffer_.erase(0, length);
+            return response;
+        }
+
+        // ԶǷѹرӣ EOF Ϊ truetimeout ݻûжΪ false
+        bool closed_by_peer(std::chrono::milliseconds timeout = std::chrono::milliseconds(2000)) {
+            if (!buffer_.empty()) {
+                return false;
+            }
+            auto deadline = std::chrono::steady_clock::now() + timeout;
+            socket_.non_blocking(true);
+            bool closed = false;
+            while (std::chrono::steady_clock::now() < deadline) {
+                char data[256];
+                asio::error_code ec;
+                size_t n = socket_.read_some(asio::buffer(data), ec);
+                if (ec == asio::error::would_block) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                    continue;
+                }
+                if (ec) {
+                    closed = true;
+                } else {
+                    buffer_.append(data, n);
+                }
+                break;
+            }
+            socket_.non_blocking(false);
+            return closed;
+        }
+
+    private:
+        asio::io_context io_context_;
+        asio::ip::tcp::socket socket_;
+        std::string buffer_;
+        bool connected_ = false;
+
+        bool fill() {
+            char data[8192];
+            asio::error_code ec;
+            size_t n = socket_.read_some(asio::buffer(data), ec);
+            if (ec) {
+                return false;
+            }
+            buffer_.append(data, n);
+            return true;
+        }
+    };
+
+} // namespace test
+
+#endif // HTTP_TEST_CLIENT_HPP
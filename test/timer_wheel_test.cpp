@@ -0,0 +1,186 @@
+// TimerWheelԽ߽磨64  4096  tickĶʱ·źʱڣ
+// ȡͬһδִеĶʱƳʱֽڷͷӣslowloris
+//  header_timeout ֮رգյݲ˳
+//   g++ -std=c++20 -O1 -I../HttpLib -I<asio ͷļĿ¼> timer_wheel_test.cpp -o timer_wheel_test -lpthread && ./timer_wheel_test
+
+#include "test.hpp"
+#include "test_client.hpp"
+#include "http_server.hpp"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace http_asio;
+using namespace std::chrono_literals;
+
+namespace {
+
+    using clock_type = std::chrono::steady_clock;
+
+    const auto kTick = 1ms;
+    const auto kSlack = 150ms;      // ˻ϵӳٵ
+
+    struct Probe {
+        TimerEntry entry;
+        std::chrono::milliseconds timeout{ 0 };
+        clock_type::time_point scheduled;
+        clock_type::duration elapsed{ 0 };
+        int fired = 0;
+    };
+
+    bool on_time(const Probe& probe) {
+        return probe.fired == 1 && probe.elapsed >= probe.timeout - kTick && probe.elapsed < probe.timeout + kSlack;
+    }
+
+    //  0 ÿ 1  tick 1  64  2  4096 ߽ĶʱڲͬĲ
+    void level_boundaries() {
+        asio::io_context io_context;
+        auto wheel = std::make_shared<TimerWheel>(io_context, kTick);
+        const std::vector<int> ticks{ 1, 63, 64, 65, 127, 128, 200, 4095, 4096, 4097, 4160 };
+        std::vector<std::unique_ptr<Probe>> probes;
+        for (int t : ticks) {
+            auto probe = std::make_unique<Probe>();
+            Probe* p = probe.get();
+            p->timeout = std::chrono::milliseconds(t);
+            p->entry.setHandler([p]() {
+                ++p->fired;
+                p->elapsed = clock_type::now() - p->scheduled;
+            });
+            probes.push_back(std::move(probe));
+        }
+        for (auto& probe : probes) {
+            probe->scheduled = clock_type::now();
+            wheel->schedule(probe->entry, probe->timeout);
+        }
+        CHECK(wheel->size() == ticks.size());
+
+        io_context.run();   // ʱպƽrun ֮
+        CHECK(wheel->size() == 0);
+        for (auto& probe : probes) {
+            if (!on_time(*probe)) {
+                std::printf("  %lld ms entry: fired %d, after %lld ms\n", static_cast<long long>(probe->timeout.count()),
+                    probe->fired, static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(probe->elapsed).count()));
+            }
+            CHECK(on_time(*probe));
+        }
+    }
+
+    void reschedule_and_cancel_in_handler() {
+        asio::io_context io_context;
+        auto wheel = std::make_shared<TimerWheel>(io_context, kTick);
+
+        // ڶʱһο 1 
+        Probe periodic;
+        int rounds = 0;
+        auto start = clock_type::now();
+        periodic.entry.setHandler([&]() {
+            ++rounds;
+            if (rounds < 3) {
+                wheel->schedule(periodic.entry, rounds == 1 ? 100ms : 10ms);
+            } else {
+                periodic.elapsed = clock_type::now() - start;
+            }
+        });
+
+        // a  b ͬʱڣһͬһִۣеһȡһ
+        Probe a, b;
+        a.entry.setHandler([&]() { ++a.fired; b.entry.cancel(); });
+        b.entry.setHandler([&]() { ++b.fired; a.entry.cancel(); });
+
+        // late ԭ 20 ms ڣ pusher Ƴٵ 90 ms
+        Probe late, pusher;
+        late.entry.setHandler([&]() {
+            ++late.fired;
+            late.elapsed = clock_type::now() - start;
+        });
+        pusher.entry.setHandler([&]() {
+            ++pusher.fired;
+            wheel->schedule(late.entry, 80ms);
+        });
+
+        wheel->schedule(periodic.entry, 5ms);
+        wheel->schedule(a.entry, 30ms);
+        wheel->schedule(b.entry, 30ms);
+        wheel->schedule(late.entry, 20ms);
+        wheel->schedule(pusher.entry, 10ms);
+        io_context.run();
+
+        CHECK(rounds == 3);
+        CHECK(periodic.elapsed >= 115ms - 3 * kTick && periodic.elapsed < 115ms + kSlack);
+        CHECK(a.fired + b.fired == 1);
+        CHECK(!a.entry.pending() && !b.entry.pending());
+        CHECK(pusher.fired == 1 && late.fired == 1);
+        CHECK(late.elapsed >= 90ms - 2 * kTick && late.elapsed < 90ms + kSlack);
+        CHECK(wheel->size() == 0);
+    }
+
+    // ĶʱԶʱժ
+    void destroyed_entry_is_unlinked() {
+        asio::io_context io_context;
+        auto wheel = std::make_shared<TimerWheel>(io_context, kTick);
+        int fired = 0;
+        {
+            TimerEntry entry([&fired]() { ++fired; });
+            wheel->schedule(entry, 5000ms);
+            CHECK(wheel->size() == 1);
+        }
+        CHECK(wheel->size() == 0);
+        io_context.run();
+        CHECK(fired == 0);
+    }
+
+    const unsigned short kPort = 18193;
+
+    // ÿ 50 ms һֽڣͷܹҪ룻Ӧ header_timeout ر
+    void slowloris_is_closed(std::chrono::milliseconds header_timeout) {
+        test::RawClient client(kPort);
+        CHECK(client.connected());
+        const std::string head = "GET / HTTP/1.1\r\nHost: localhost\r\nX-Slow: aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\r\n\r\n";
+        auto start = clock_type::now();
+        bool closed = false;
+        for (char c : head) {
+            if (!client.send(std::string(1, c)) || client.closed_by_peer(50ms)) {
+                closed = true;
+                break;
+            }
+        }
+        auto elapsed = clock_type::now() - start;
+        CHECK(closed);
+        // ھΪʱֵһ tick
+        const auto tick = std::chrono::milliseconds(CPPHTTPLIB_TIMER_WHEEL_TICK_MSECOND);
+        CHECK(elapsed >= header_timeout - tick);
+        CHECK(elapsed < header_timeout + 2 * tick + kSlack);
+    }
+
+    void fast_client_is_served() {
+        test::RawClient client(kPort);
+        CHECK(client.send("GET / HTTP/1.1\r\nHost: localhost\r\n\r\n"));
+        auto response = client.read_response();
+        CHECK(response && response->status == 200 && response->body == "ok");
+    }
+
+} // namespace
+
+int main() {
+    level_boundaries();
+    reschedule_and_cancel_in_handler();
+    destroyed_entry_is_unlinked();
+
+    const auto header_timeout = 500ms;
+    Server server(kPort);
+    server.Get("/", [](const Request&, Response& res) {
+        res.setContent("ok", "text/plain");
+    });
+    server.set_header_timeout(header_timeout);
+    std::thread reactor([&server]() { server.Run(); });
+
+    slowloris_is_closed(header_timeout);
+    fast_client_is_served();
+
+    server.Stop();
+    reactor.join();
+    return TEST_RESULT();
+}